@@ -1,30 +1,231 @@
+#if defined(SSD1306_ENABLE_STATS) && defined(SSD1306_HOST)
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
 #include "ssd1306.h"
 #include <stdlib.h>
+#include <string.h>
+#if defined(SSD1306_ENABLE_STATS) && !defined(SSD1306_HOST)
+#include "pico/time.h"
+#endif
 
-SSD1306_Display *ssd1306_init(void)
+#ifdef SSD1306_ENABLE_STATS
+static uint64_t ssd1306_time_us(void)
 {
-    uint8_t *buffer = malloc(sizeof(uint8_t) * 1025);
-    *(buffer) = SSD1306_CONTROL_BYTE_DATA;
+#ifdef SSD1306_HOST
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000u + (uint64_t)t.tv_nsec / 1000u;
+#else
+    return time_us_64();
+#endif
+}
+
+/**
+ * Closes the render period and opens the transmit period of a frame
+ * @param d pointer to SSD1306_Display
+ */
+static void ssd1306_stats_begin_update(SSD1306_Display *d)
+{
+    uint64_t now = ssd1306_time_us();
+    d->stats.last_render_us = (uint32_t)(now - d->stats_mark_us);
+    d->stats.render_us += d->stats.last_render_us;
+    d->stats.frames++;
+    d->stats_mark_us = now;
+}
+
+/**
+ * Closes the transmit period of a frame
+ * @param d pointer to SSD1306_Display
+ */
+static void ssd1306_stats_end_update(SSD1306_Display *d)
+{
+    uint64_t now = ssd1306_time_us();
+    d->stats.last_transmit_us = (uint32_t)(now - d->stats_mark_us);
+    d->stats.transmit_us += d->stats.last_transmit_us;
+    d->stats_mark_us = now;
+}
+#else
+#define ssd1306_stats_begin_update(d) ((void)0)
+#define ssd1306_stats_end_update(d) ((void)0)
+#endif
+
+/**
+ * Builds the command frame that addresses a GDDRAM window
+ * @param d pointer to SSD1306_Display
+ * @param w window to address
+ * @param commands SSD1306_WINDOW_COMMAND_LENGTH bytes to fill, control byte included
+ */
+static void ssd1306_window_commands(const SSD1306_Display *d, const SSD1306_Window *w, uint8_t *commands)
+{
+    commands[0] = SSD1306_CONTROL_BYTE_COMMAND;
+    commands[1] = SSD1306_SET_COLUMN_ADDRESS;
+    commands[2] = d->column_offset + w->column_start;
+    commands[3] = d->column_offset + w->column_end;
+    commands[4] = SSD1306_SET_PAGE_ADDRESS;
+    commands[5] = w->page_start;
+    commands[6] = w->page_end;
+}
+
+/**
+ * Writes a window of a frame on the SSD1306 GDDRAM
+ * @param d pointer to SSD1306_Display
+ * @param frame frame to write, d->frame or d->front
+ * @param w window to write
+ * @note The frame byte preceding each data frame holds the data control byte during the transfer
+ */
+static void ssd1306_write_window(SSD1306_Display *d, uint8_t *frame, const SSD1306_Window *w)
+{
+    uint8_t window_commands[SSD1306_WINDOW_COMMAND_LENGTH];
+    ssd1306_window_commands(d, w, window_commands);
+    ssd1306_write_commands(d, window_commands, SSD1306_WINDOW_COMMAND_LENGTH);
+
+    uint32_t columns = w->column_end - w->column_start + 1;
+    uint32_t length = columns + 1;
+    uint8_t frames = w->page_end - w->page_start + 1;
+    if (columns == SSD1306_WIDTH(d))
+    {
+        length = frames * SSD1306_WIDTH(d) + 1;
+        frames = 1;
+    }
+    uint8_t *data = frame + w->page_start * SSD1306_WIDTH(d) + w->column_start;
+    while (frames--)
+    {
+        uint8_t saved = *data;
+        *data = SSD1306_CONTROL_BYTE_DATA;
+        ssd1306_write_data(d, data, length);
+        *data = saved;
+        data += SSD1306_WIDTH(d);
+    }
+}
+
+/**
+ * Copies a window of a frame into the shadow frame
+ * @param d pointer to SSD1306_Display with shadow frame
+ * @param frame frame written on the GDDRAM
+ * @param w window written
+ */
+static void ssd1306_shadow_window(SSD1306_Display *d, const uint8_t *frame, const SSD1306_Window *w)
+{
+    uint32_t index = 1 + w->page_start * SSD1306_WIDTH(d) + w->column_start;
+    for (uint8_t page = w->page_start; page <= w->page_end; page++, index += SSD1306_WIDTH(d))
+        memcpy(d->shadow + index, frame + index, w->column_end - w->column_start + 1);
+}
+
+/**
+ * Encodes the dirty regions of a frame as a SSD1306_Update_Plan
+ * @param d pointer to SSD1306_Display
+ * @param frame frame to write
+ * @param plan pointer to SSD1306_Update_Plan to fill
+ * @return bytes handed to the transport by the plan
+ */
+static uint32_t ssd1306_encode_frame(const SSD1306_Display *d, const uint8_t *frame, SSD1306_Update_Plan *plan)
+{
+    const uint8_t *previous = d->shadow_valid ? d->shadow : NULL;
+    return ssd1306_encode_diff(previous, frame, SSD1306_WIDTH(d), SSD1306_PAGES(d), d->dirty_start, d->dirty_end, plan);
+}
+
+/**
+ * Marks every page of the SSD1306_Display frame as clean
+ * @param d pointer to SSD1306_Display
+ */
+static void ssd1306_reset_dirty(SSD1306_Display *d)
+{
+    memset(d->dirty_start, SSD1306_CLEAN_PAGE, SSD1306_MAX_PAGES);
+    memset(d->dirty_end, 0, SSD1306_MAX_PAGES);
+}
 
+const SSD1306_Geometry ssd1306_128x64 = {.width = 128, .height = 64, .column_offset = 0, .com_pins = 0x12};
+const SSD1306_Geometry ssd1306_128x32 = {.width = 128, .height = 32, .column_offset = 0, .com_pins = 0x02};
+const SSD1306_Geometry ssd1306_96x16 = {.width = 96, .height = 16, .column_offset = 0, .com_pins = 0x02};
+const SSD1306_Geometry ssd1306_72x40 = {.width = 72, .height = 40, .column_offset = 28, .com_pins = 0x12};
+const SSD1306_Geometry ssd1306_64x48 = {.width = 64, .height = 48, .column_offset = 32, .com_pins = 0x12};
+
+SSD1306_Display *ssd1306_init_transport(const SSD1306_Transport *transport, void *context)
+{
+#ifdef SSD1306_FIXED_WIDTH
+    const SSD1306_Geometry *geometries[] = {&ssd1306_128x64, &ssd1306_128x32, &ssd1306_96x16, &ssd1306_72x40, &ssd1306_64x48};
+    for (uint8_t i = 0; i < sizeof(geometries) / sizeof(geometries[0]); i++)
+    {
+        if (geometries[i]->width == SSD1306_FIXED_WIDTH && geometries[i]->height == SSD1306_FIXED_HEIGHT)
+            return ssd1306_init_geometry(geometries[i], transport, context);
+    }
+    return NULL;
+#else
+    return ssd1306_init_geometry(&ssd1306_128x64, transport, context);
+#endif
+}
+
+SSD1306_Display *ssd1306_init_geometry(const SSD1306_Geometry *g, const SSD1306_Transport *transport, void *context)
+{
     SSD1306_Display *display = malloc(sizeof(SSD1306_Display));
-    display->width = 128;
-    display->heigth = 64;
-    display->pages = 8;
-    display->max_x = 127;
-    display->max_y = 64;
-    display->frame_length = 1025;
-    display->frame = buffer;
-    display->cursor_position = 1;
-    display->line_limit = 128;
+    uint8_t *frame = malloc(sizeof(uint8_t) * SSD1306_FRAME_LENGTH(g->width, g->height));
+    if (display == NULL || frame == NULL)
+    {
+        free(display);
+        free(frame);
+        return NULL;
+    }
+    const SSD1306_Buffers buffers = {.frame = frame, .front = NULL, .shadow = NULL};
+    if (ssd1306_init_static(display, &buffers, g, transport, context) == NULL)
+    {
+        free(display);
+        free(frame);
+        return NULL;
+    }
+    display->owned_buffers = SSD1306_OWNS_DISPLAY | SSD1306_OWNS_FRAME;
+    return display;
+}
+
+SSD1306_Display *ssd1306_init_static(SSD1306_Display *display, const SSD1306_Buffers *b, const SSD1306_Geometry *g,
+                                     const SSD1306_Transport *transport, void *context)
+{
+#ifdef SSD1306_FIXED_WIDTH
+    if (g->width != SSD1306_FIXED_WIDTH || g->height != SSD1306_FIXED_HEIGHT)
+        return NULL;
+#endif
+    uint8_t pages = g->height >> 3;
+    uint32_t frame_length = SSD1306_FRAME_LENGTH(g->width, g->height);
+    if (pages > SSD1306_MAX_PAGES || b->frame == NULL)
+        return NULL;
+
+    display->width = g->width;
+    display->heigth = g->height;
+    display->pages = pages;
+    display->max_x = g->width - 1;
+    display->max_y = g->height - 1;
+    display->column_offset = g->column_offset;
+    display->frame_length = frame_length;
+    display->frame = b->frame;
+    display->front = b->front;
+    display->shadow = b->shadow;
+    display->shadow_valid = false;
+    display->owned_buffers = 0;
+    ssd1306_set_draw_mode(display, SSD1306_DRAW_SET);
+    ssd1306_reset_clip(display);
+    display->font = NULL;
+    display->cursor_x = 0;
+    display->cursor_y = 0;
+    display->transport = transport;
+    display->transport_context = context;
+    display->busy = false;
+    display->update_callback = NULL;
+    display->update_user_data = NULL;
+    ssd1306_reset_stats(display);
+    display->frame[0] = SSD1306_CONTROL_BYTE_DATA;
+    memset(display->frame + 1, 0x00, frame_length - 1);
+    if (display->front != NULL)
+        memcpy(display->front, display->frame, frame_length);
+    ssd1306_invalidate(display);
 
     const uint8_t init_commands[27] = {
         SSD1306_CONTROL_BYTE_COMMAND,
-        SSD1306_SET_MULTIPLEX_RATIO, 0x3F,
+        SSD1306_SET_MULTIPLEX_RATIO, g->height - 1,
         SSD1306_SET_DISPLAY_OFFSET, 0x00,
         SSD1306_SET_DISPLAY_START_LINE(0x00),
         SSD1306_SET_SEGMENT_REMAP_0,
         SSD1306_SET_COM_SCAN_DIRECTION_NORMAL_MODE,
-        SSD1306_SET_COM_PINS_HARDWARE_CONFIGURATION, 0x12,
+        SSD1306_SET_COM_PINS_HARDWARE_CONFIGURATION, g->com_pins,
         SSD1306_SET_CONTRAST_CONTROL, 0x7F,
         SSD1306_RESUME_TO_RAM_CONTENT,
         SSD1306_SET_NORMAL_DISPLAY,
@@ -33,9 +234,9 @@ SSD1306_Display *ssd1306_init(void)
         SSD1306_SET_DISPLAY_ON,
         SSD1306_SET_MEMORY_ADDRESSING_MODE,
         SSD1306_HORIZONTAL_ADDRESSING_MODE,
-        SSD1306_SET_COLUMN_ADDRESS, 0x00, 0x7F,
-        SSD1306_SET_PAGE_ADDRESS, 0x00, 0x07};
-    ssd1306_write(init_commands, 27);
+        SSD1306_SET_COLUMN_ADDRESS, g->column_offset, g->column_offset + g->width - 1,
+        SSD1306_SET_PAGE_ADDRESS, 0x00, pages - 1};
+    ssd1306_write_commands(display, init_commands, 27);
 
     return display;
 }
@@ -44,261 +245,1676 @@ void ssd1306_destroy_display(SSD1306_Display *d)
 {
     if (d != NULL)
     {
-        if (d->frame != NULL)
+        if (d->owned_buffers & SSD1306_OWNS_FRAME)
             free(d->frame);
-        free(d->frame);
+        if (d->owned_buffers & SSD1306_OWNS_FRONT)
+            free(d->front);
+        if (d->owned_buffers & SSD1306_OWNS_SHADOW)
+            free(d->shadow);
+        if (d->owned_buffers & SSD1306_OWNS_DISPLAY)
+            free(d);
     }
 }
 
+/**
+ * Frame word accessed by the bulk raster operations
+ */
+typedef uint32_t __attribute__((__may_alias__)) ssd1306_word_t;
+#define SSD1306_WORD_BYTES sizeof(ssd1306_word_t)
+#define SSD1306_WORD_REPEAT(byte) ((ssd1306_word_t)(byte) * 0x01010101u)
+
+/**
+ * Applies b = (b & keep) ^ toggle to a run of frame bytes, a 32-bit word at a time
+ * from the first aligned byte
+ * @param p first byte of the run
+ * @param n length of the run
+ * @param keep bits kept from each byte
+ * @param toggle bits inverted in each byte
+ * @param first set to the index of the first changed byte, rounded down to its word
+ * @param last set to the index of the last changed byte, rounded up to its word
+ * @return true if any byte changed
+ */
+static bool ssd1306_raster_run(uint8_t *p, uint32_t n, uint8_t keep, uint8_t toggle, uint32_t *first, uint32_t *last)
+{
+    bool changed = false;
+    uint32_t i = 0;
+    uint32_t head = (uint32_t)(-(uintptr_t)p & (SSD1306_WORD_BYTES - 1));
+    if (head > n)
+        head = n;
+    for (; i < head; i++)
+    {
+        uint8_t value = (p[i] & keep) ^ toggle;
+        if (value != p[i])
+        {
+            p[i] = value;
+            if (!changed)
+                *first = i;
+            *last = i;
+            changed = true;
+        }
+    }
+    ssd1306_word_t keep_word = SSD1306_WORD_REPEAT(keep);
+    ssd1306_word_t toggle_word = SSD1306_WORD_REPEAT(toggle);
+    for (; i + SSD1306_WORD_BYTES <= n; i += SSD1306_WORD_BYTES)
+    {
+        ssd1306_word_t *w = (ssd1306_word_t *)(p + i);
+        ssd1306_word_t value = (*w & keep_word) ^ toggle_word;
+        if (value != *w)
+        {
+            *w = value;
+            if (!changed)
+                *first = i;
+            *last = i + SSD1306_WORD_BYTES - 1;
+            changed = true;
+        }
+    }
+    for (; i < n; i++)
+    {
+        uint8_t value = (p[i] & keep) ^ toggle;
+        if (value != p[i])
+        {
+            p[i] = value;
+            if (!changed)
+                *first = i;
+            *last = i;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/**
+ * Mask of the rows of a page covered by the rows y1 to y2
+ * @param page page index
+ * @param y1 first row
+ * @param y2 last row
+ */
+static inline uint8_t ssd1306_page_mask(uint8_t page, uint8_t y1, uint8_t y2)
+{
+    uint8_t mask = 0xFF;
+    if (y1 >> 3 == page)
+        mask &= 0xFF << (y1 & 7);
+    if (y2 >> 3 == page)
+        mask &= 0xFF >> (7 - (y2 & 7));
+    return mask;
+}
+
+/**
+ * Intersects the rectangle of corners (x1, y1) and (x2, y2) with the area of corners
+ * (left, top) and (right, bottom), in place
+ * @return false if the intersection is empty
+ */
+static bool ssd1306_intersect(int32_t *x1, int32_t *y1, int32_t *x2, int32_t *y2, int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    if (*x1 < left)
+        *x1 = left;
+    if (*y1 < top)
+        *y1 = top;
+    if (*x2 > right)
+        *x2 = right;
+    if (*y2 > bottom)
+        *y2 = bottom;
+    return *x1 <= *x2 && *y1 <= *y2;
+}
+
+/**
+ * Applies b = (b & ~(m & clear)) ^ (m & toggle) to every page byte of an area inside the
+ * display, m being the mask of the rows covered in that page, and marks the changed bytes as dirty
+ * @param d pointer to SSD1306_Display
+ */
+static void ssd1306_raster_area(SSD1306_Display *d, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t clear, uint8_t toggle)
+{
+    uint32_t n = x2 - x1 + 1;
+    for (uint8_t page = y1 >> 3; page <= y2 >> 3; page++)
+    {
+        uint8_t mask = ssd1306_page_mask(page, y1, y2);
+        uint32_t first, last;
+        uint8_t *p = d->frame + 1 + x1 + page * SSD1306_WIDTH(d);
+        if (ssd1306_raster_run(p, n, ~(mask & clear), mask & toggle, &first, &last))
+            ssd1306_mark_dirty(d, page, x1 + first, x1 + last);
+    }
+}
+
+/**
+ * Applies ssd1306_raster_area to a rectangle clipped to the clip rectangle
+ * @param d pointer to SSD1306_Display
+ */
+static void ssd1306_raster_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height, uint8_t clear, uint8_t toggle)
+{
+    int32_t x1 = x, y1 = y, x2 = (int32_t)x + width - 1, y2 = (int32_t)y + height - 1;
+    if (ssd1306_intersect(&x1, &y1, &x2, &y2, d->clip_x1, d->clip_y1, d->clip_x2, d->clip_y2))
+        ssd1306_raster_area(d, x1, y1, x2, y2, clear, toggle);
+}
+
+/**
+ * Draws the pixels of row y from column x1 to x2, a single masked operation over the page row
+ * @param d pointer to SSD1306_Display
+ */
+static void ssd1306_draw_hspan(SSD1306_Display *d, uint8_t x1, uint8_t x2, uint8_t y)
+{
+    uint8_t page = y >> 3;
+    uint8_t mask = 1 << (y & 7);
+    uint32_t first, last;
+    uint8_t *p = d->frame + 1 + x1 + page * SSD1306_WIDTH(d);
+    if (ssd1306_raster_run(p, x2 - x1 + 1, ~(mask & d->draw_clear), mask & d->draw_toggle, &first, &last))
+        ssd1306_mark_dirty(d, page, x1 + first, x1 + last);
+}
+
+/**
+ * Draws the pixels of column x from row y1 to y2, one byte per page
+ * @param d pointer to SSD1306_Display
+ */
+static void ssd1306_draw_vspan(SSD1306_Display *d, uint8_t x, uint8_t y1, uint8_t y2)
+{
+    uint8_t *p = d->frame + 1 + x + (y1 >> 3) * SSD1306_WIDTH(d);
+    for (uint8_t page = y1 >> 3; page <= y2 >> 3; page++, p += SSD1306_WIDTH(d))
+    {
+        uint8_t mask = ssd1306_page_mask(page, y1, y2);
+        uint8_t value = (*p & ~(mask & d->draw_clear)) ^ (mask & d->draw_toggle);
+        if (value != *p)
+        {
+            *p = value;
+            ssd1306_mark_dirty(d, page, x, x);
+        }
+    }
+}
+
+/**
+ * Draws the pixels of column x from row y1 to y2, in any order and clipped to the clip rectangle
+ * @param d pointer to SSD1306_Display
+ */
+static void ssd1306_fill_column(SSD1306_Display *d, int32_t x, int32_t y1, int32_t y2)
+{
+    if (y1 > y2)
+    {
+        int32_t t = y1;
+        y1 = y2;
+        y2 = t;
+    }
+    if (x < d->clip_x1 || x > d->clip_x2 || y2 < d->clip_y1 || y1 > d->clip_y2)
+        return;
+    ssd1306_draw_vspan(d, x, y1 < d->clip_y1 ? d->clip_y1 : y1, y2 > d->clip_y2 ? d->clip_y2 : y2);
+}
+
+void ssd1306_clear_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    ssd1306_raster_rect(d, x, y, width, height, 0xFF, 0x00);
+}
+
+void ssd1306_fill_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    ssd1306_raster_rect(d, x, y, width, height, 0xFF, 0xFF);
+}
+
+void ssd1306_invert_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    ssd1306_raster_rect(d, x, y, width, height, 0x00, 0xFF);
+}
+
+void ssd1306_set_draw_mode(SSD1306_Display *d, uint8_t mode)
+{
+    /* SET: (b & ~m) ^ m, CLEAR: b & ~m, XOR: b ^ m */
+    static const uint8_t clear[3] = {0xFF, 0xFF, 0x00};
+    static const uint8_t toggle[3] = {0xFF, 0x00, 0xFF};
+    if (mode > SSD1306_DRAW_XOR)
+        return;
+    d->draw_mode = mode;
+    d->draw_clear = clear[mode];
+    d->draw_toggle = toggle[mode];
+}
+
+void ssd1306_set_clip(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    int32_t x1 = x, y1 = y, x2 = (int32_t)x + width - 1, y2 = (int32_t)y + height - 1;
+    if (!ssd1306_intersect(&x1, &y1, &x2, &y2, 0, 0, d->max_x, d->max_y))
+    {
+        /* Empty clip rectangle: every coordinate is rejected */
+        x1 = 1;
+        x2 = 0;
+        y1 = 1;
+        y2 = 0;
+    }
+    d->clip_x1 = x1;
+    d->clip_y1 = y1;
+    d->clip_x2 = x2;
+    d->clip_y2 = y2;
+}
+
+void ssd1306_reset_clip(SSD1306_Display *d)
+{
+    d->clip_x1 = 0;
+    d->clip_y1 = 0;
+    d->clip_x2 = d->max_x;
+    d->clip_y2 = d->max_y;
+}
+
+bool ssd1306_copy_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height, int16_t dx, int16_t dy)
+{
+    if (((dy - y) & 7) != 0)
+        return false;
+    /* Source inside the display, destination inside the clip rectangle */
+    int32_t offset_x = dx - x, offset_y = dy - y;
+    int32_t x1 = x, y1 = y, x2 = (int32_t)x + width - 1, y2 = (int32_t)y + height - 1;
+    if (!ssd1306_intersect(&x1, &y1, &x2, &y2, 0, 0, d->max_x, d->max_y))
+        return true;
+    x1 += offset_x;
+    x2 += offset_x;
+    y1 += offset_y;
+    y2 += offset_y;
+    if (!ssd1306_intersect(&x1, &y1, &x2, &y2, d->clip_x1, d->clip_y1, d->clip_x2, d->clip_y2))
+        return true;
+    uint32_t n = x2 - x1 + 1;
+    int32_t page_offset = offset_y / 8;
+    uint8_t first_page = y1 >> 3;
+    uint8_t last_page = y2 >> 3;
+    /* Walk the pages away from the overlap, like memmove */
+    bool down = page_offset > 0;
+    for (uint8_t i = 0; i <= last_page - first_page; i++)
+    {
+        uint8_t page = down ? last_page - i : first_page + i;
+        uint8_t mask = ssd1306_page_mask(page, y1, y2);
+        uint8_t *to = d->frame + 1 + x1 + page * SSD1306_WIDTH(d);
+        const uint8_t *from = d->frame + 1 + (x1 - offset_x) + (page - page_offset) * SSD1306_WIDTH(d);
+        if (mask == 0xFF)
+            memmove(to, from, n);
+        else if (to <= from)
+        {
+            for (uint32_t c = 0; c < n; c++)
+                to[c] = (to[c] & ~mask) | (from[c] & mask);
+        }
+        else
+        {
+            for (uint32_t c = n; c-- > 0;)
+                to[c] = (to[c] & ~mask) | (from[c] & mask);
+        }
+        ssd1306_mark_dirty(d, page, x1, x2);
+    }
+    return true;
+}
+
 void ssd1306_clean(SSD1306_Display *d)
 {
-    d->cursor_position = 1;
-    d->line_limit = 128;
-    uint32_t i = d->frame_length;
-    while (--i)
-        *(d->frame + i) = 0x00;
+    d->cursor_x = 0;
+    d->cursor_y = 0;
+    ssd1306_raster_area(d, 0, 0, d->max_x, d->max_y, 0xFF, 0x00);
+}
+
+/**
+ * Writes the dirty regions of a frame on the SSD1306 GDDRAM
+ * @param d pointer to SSD1306_Display
+ * @param frame frame to write, d->frame or d->front
+ */
+static void ssd1306_write_dirty(SSD1306_Display *d, uint8_t *frame)
+{
+    SSD1306_Update_Plan plan;
+    ssd1306_encode_frame(d, frame, &plan);
+    for (uint8_t i = 0; i < plan.count; i++)
+    {
+        ssd1306_write_window(d, frame, &plan.windows[i]);
+        if (d->shadow != NULL)
+            ssd1306_shadow_window(d, frame, &plan.windows[i]);
+    }
+    if (d->shadow != NULL)
+        d->shadow_valid = true;
+}
+
+uint32_t ssd1306_plan_update(const SSD1306_Display *d, SSD1306_Update_Plan *plan)
+{
+    return ssd1306_encode_frame(d, d->frame, plan);
+}
+
+bool ssd1306_enable_diff_encoding(SSD1306_Display *d)
+{
+    if (d->shadow != NULL)
+        return true;
+    uint8_t *buffer = malloc(sizeof(uint8_t) * d->frame_length);
+    if (buffer == NULL)
+        return false;
+    ssd1306_wait_update(d);
+    memcpy(buffer, d->frame, d->frame_length);
+    d->shadow = buffer;
+    d->shadow_valid = false;
+    d->owned_buffers |= SSD1306_OWNS_SHADOW;
+    return true;
+}
+
+/**
+ * Swaps the front and back buffers and copies the dirty regions of the new front
+ * buffer into the new back buffer, so the renderer keeps drawing over the last frame
+ * @param d pointer to SSD1306_Display in double buffer mode
+ */
+static void ssd1306_swap_buffers(SSD1306_Display *d)
+{
+    uint8_t *front = d->frame;
+    d->frame = d->front;
+    d->front = front;
+    for (uint8_t page = 0; page < SSD1306_PAGES(d); page++)
+    {
+        if (d->dirty_start[page] != SSD1306_CLEAN_PAGE)
+        {
+            uint32_t index = 1 + page * SSD1306_WIDTH(d) + d->dirty_start[page];
+            memcpy(d->frame + index, d->front + index, d->dirty_end[page] - d->dirty_start[page] + 1);
+        }
+    }
 }
 
 void ssd1306_update_graphics(SSD1306_Display *d)
 {
-    ssd1306_write(d->frame, d->frame_length);
-}
-
-void ssd1306_draw_line(SSD1306_Display *d, int8_t x1, int8_t y1, int8_t x2, int8_t y2)
-{
-    if ((y1 > 0 || y2 > 0) && (x1 > 0 || x2 > 0))
-    {
-        if (y1 < 0)
-            y1 = 0;
-        else if (y1 > d->max_y)
-            y1 = d->max_y;
-        if (y2 < 0)
-            y2 = 0;
-        else if (y2 > d->max_y)
-            y2 = d->max_y;
-        if (x1 < 0)
-            x1 = 0;
-        else if (x1 > d->max_x)
-            x1 = d->max_x;
-        if (x2 < 0)
-            x2 = 0;
-        else if (x2 > d->max_x)
-            x2 = d->max_x;
-
-        int16_t dx = x2 - x1;
-        int16_t dy = y2 - y1;
-        int16_t sx = 1;
-        int16_t sy = 1;
-        if (dx < 0)
+    ssd1306_wait_update(d);
+    ssd1306_stats_begin_update(d);
+    uint8_t *frame = d->frame;
+    if (d->front != NULL)
+    {
+        ssd1306_swap_buffers(d);
+        frame = d->front;
+    }
+    ssd1306_write_dirty(d, frame);
+    ssd1306_reset_dirty(d);
+    ssd1306_stats_end_update(d);
+}
+
+static void ssd1306_update_done(void *user_data);
+
+/**
+ * Submits the next transfer of the asynchronous update in progress: the command frame
+ * of the next window, or its next data frame, split like ssd1306_write_window does
+ * @param d pointer to SSD1306_Display with an asynchronous update in progress
+ * @return false if the transport refused the transfer
+ */
+static bool ssd1306_submit_update(SSD1306_Display *d)
+{
+    const SSD1306_Window *w = &d->update_plan.windows[d->update_window];
+    if (d->update_page == SSD1306_CLEAN_PAGE)
+    {
+        ssd1306_window_commands(d, w, d->update_commands);
+        d->update_page = w->page_start;
+        SSD1306_STATS_ADD(d, bytes, SSD1306_WINDOW_COMMAND_LENGTH);
+        SSD1306_STATS_ADD(d, transactions, 1);
+        return d->transport->submit_async(d->transport_context, d->update_commands, SSD1306_WINDOW_COMMAND_LENGTH,
+                                          ssd1306_update_done, d);
+    }
+
+    uint32_t columns = w->column_end - w->column_start + 1;
+    uint32_t length = columns + 1;
+    uint8_t *data = d->update_frame + d->update_page * SSD1306_WIDTH(d) + w->column_start;
+    d->update_page++;
+    if (columns == SSD1306_WIDTH(d))
+    {
+        length = (w->page_end - w->page_start + 1) * SSD1306_WIDTH(d) + 1;
+        d->update_page = w->page_end + 1;
+    }
+    if (d->update_page > w->page_end)
+    {
+        d->update_window++;
+        d->update_page = SSD1306_CLEAN_PAGE;
+    }
+    uint8_t saved = *data;
+    *data = SSD1306_CONTROL_BYTE_DATA;
+    SSD1306_STATS_ADD(d, bytes, length);
+    SSD1306_STATS_ADD(d, transactions, 1);
+    bool started = d->transport->submit_async(d->transport_context, data, length, ssd1306_update_done, d);
+    *data = saved;
+    return started;
+}
+
+/**
+ * Transport callback of the asynchronous updates: queues the next transfer of the plan,
+ * or finishes the update after the last one
+ * @param user_data pointer to SSD1306_Display
+ */
+static void ssd1306_update_done(void *user_data)
+{
+    SSD1306_Display *d = user_data;
+    if (d->update_window < d->update_plan.count)
+    {
+        if (ssd1306_submit_update(d))
+            return;
+        /* The rest of the plan never reached the GDDRAM, the next update rewrites everything */
+        ssd1306_invalidate(d);
+    }
+    ssd1306_stats_end_update(d);
+    d->busy = false;
+    if (d->update_callback != NULL)
+        d->update_callback(d->update_user_data);
+}
+
+bool ssd1306_update_graphics_async(SSD1306_Display *d, SSD1306_Callback callback, void *user_data)
+{
+    ssd1306_wait_update(d);
+    ssd1306_stats_begin_update(d);
+    uint8_t *frame = d->frame;
+    if (d->front != NULL)
+    {
+        ssd1306_swap_buffers(d);
+        frame = d->front;
+    }
+    if (d->transport->submit_async == NULL)
+    {
+        ssd1306_write_dirty(d, frame);
+        ssd1306_reset_dirty(d);
+        ssd1306_stats_end_update(d);
+        if (callback != NULL)
+            callback(user_data);
+        return true;
+    }
+
+    ssd1306_encode_frame(d, frame, &d->update_plan);
+    ssd1306_reset_dirty(d);
+    if (d->update_plan.count == 0)
+    {
+        ssd1306_stats_end_update(d);
+        if (callback != NULL)
+            callback(user_data);
+        return true;
+    }
+    if (d->shadow != NULL)
+    {
+        for (uint8_t i = 0; i < d->update_plan.count; i++)
+            ssd1306_shadow_window(d, frame, &d->update_plan.windows[i]);
+        d->shadow_valid = true;
+    }
+    d->update_callback = callback;
+    d->update_user_data = user_data;
+    d->update_frame = frame;
+    d->update_window = 0;
+    d->update_page = SSD1306_CLEAN_PAGE;
+    d->busy = true;
+    if (!ssd1306_submit_update(d))
+    {
+        d->busy = false;
+        d->shadow_valid = false;
+        for (uint8_t i = 0; i < d->update_plan.count; i++)
+        {
+            const SSD1306_Window *w = &d->update_plan.windows[i];
+            for (uint8_t page = w->page_start; page <= w->page_end; page++)
+                ssd1306_mark_dirty(d, page, w->column_start, w->column_end);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool ssd1306_enable_double_buffer(SSD1306_Display *d)
+{
+    if (d->front != NULL)
+        return true;
+    uint8_t *buffer = malloc(sizeof(uint8_t) * d->frame_length);
+    if (buffer == NULL)
+        return false;
+    ssd1306_wait_update(d);
+    memcpy(buffer, d->frame, d->frame_length);
+    d->front = buffer;
+    d->owned_buffers |= SSD1306_OWNS_FRONT;
+    return true;
+}
+
+void ssd1306_get_stats(const SSD1306_Display *d, SSD1306_Stats *stats)
+{
+#ifdef SSD1306_ENABLE_STATS
+    *stats = d->stats;
+#else
+    (void)d;
+    memset(stats, 0, sizeof(SSD1306_Stats));
+#endif
+}
+
+void ssd1306_reset_stats(SSD1306_Display *d)
+{
+#ifdef SSD1306_ENABLE_STATS
+    memset(&d->stats, 0, sizeof(SSD1306_Stats));
+    d->stats_mark_us = ssd1306_time_us();
+#else
+    (void)d;
+#endif
+}
+
+void ssd1306_wait_update(SSD1306_Display *d)
+{
+    /* Every completed transfer queues the next one of the plan until the last */
+    while (d->busy)
+        d->transport->flush(d->transport_context);
+}
+
+void ssd1306_invalidate(SSD1306_Display *d)
+{
+    d->shadow_valid = false;
+    memset(d->dirty_start, 0, SSD1306_MAX_PAGES);
+    memset(d->dirty_end, d->max_x, SSD1306_MAX_PAGES);
+}
+
+/**
+ * Position of a bounding box relative to the clip rectangle
+ */
+#define SSD1306_CLIP_OUTSIDE 0
+#define SSD1306_CLIP_PARTIAL 1
+#define SSD1306_CLIP_INSIDE 2
+
+static uint8_t ssd1306_classify(const SSD1306_Display *d, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    if (x2 < d->clip_x1 || x1 > d->clip_x2 || y2 < d->clip_y1 || y1 > d->clip_y2)
+        return SSD1306_CLIP_OUTSIDE;
+    if (x1 >= d->clip_x1 && x2 <= d->clip_x2 && y1 >= d->clip_y1 && y2 <= d->clip_y2)
+        return SSD1306_CLIP_INSIDE;
+    return SSD1306_CLIP_PARTIAL;
+}
+
+/**
+ * Row of a line at successive columns, or column at successive rows, rounded to the nearest
+ */
+typedef struct ssd1306_edge
+{
+    int32_t y;
+    int32_t step;
+    /** Fraction of a row in 1 / divisor units */
+    int32_t error;
+    int32_t error_step;
+    int32_t divisor;
+} SSD1306_Edge;
+
+/**
+ * Floor of n / m
+ * @param n numerator
+ * @param m denominator, greater than 0
+ */
+static int64_t ssd1306_divide_floor(int64_t n, int64_t m)
+{
+    int64_t q = n / m;
+    return (n % m != 0 && n < 0) ? q - 1 : q;
+}
+
+/**
+ * Starts walking the edge from (x1, y1) to (x2, y2) at column c, x being the major axis
+ * @param e edge
+ * @param c first column, x1 < x2
+ */
+static void ssd1306_edge_init(SSD1306_Edge *e, int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t c)
+{
+    /* Row at column c: y1 + floor((2 * dy * (c - x1) + dx) / (2 * dx)) */
+    int64_t divisor = 2 * (int64_t)(x2 - x1);
+    int64_t rise = 2 * (int64_t)(y2 - y1);
+    int64_t n = rise * (c - x1) + (x2 - x1);
+    int64_t q = ssd1306_divide_floor(n, divisor);
+    e->y = y1 + q;
+    e->error = n - q * divisor;
+    e->step = ssd1306_divide_floor(rise, divisor);
+    e->error_step = rise - e->step * divisor;
+    e->divisor = divisor;
+}
+
+static inline void ssd1306_edge_step(SSD1306_Edge *e)
+{
+    e->y += e->step;
+    e->error += e->error_step;
+    if (e->error >= e->divisor)
+    {
+        e->y++;
+        e->error -= e->divisor;
+    }
+}
+
+void ssd1306_draw_line(SSD1306_Display *d, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+    int32_t left = x1 < x2 ? x1 : x2;
+    int32_t right = x1 < x2 ? x2 : x1;
+    int32_t top = y1 < y2 ? y1 : y2;
+    int32_t bottom = y1 < y2 ? y2 : y1;
+    if (ssd1306_classify(d, left, top, right, bottom) == SSD1306_CLIP_OUTSIDE)
+        return;
+    if (top == bottom)
+        ssd1306_draw_hspan(d, left < d->clip_x1 ? d->clip_x1 : left, right > d->clip_x2 ? d->clip_x2 : right, top);
+    else if (left == right)
+        ssd1306_draw_vspan(d, left, top < d->clip_y1 ? d->clip_y1 : top, bottom > d->clip_y2 ? d->clip_y2 : bottom);
+    else
+    {
+        /* Walk the major axis inside the clip rectangle only: the minor coordinate of each
+         * step comes from the exact line equation, so clipping never bends the line */
+        bool steep = bottom - top > right - left;
+        int32_t ax = x1, ay = y1, bx = x2, by = y2;
+        if (steep)
         {
-            dx = -dx;
-            sx = -1;
+            ax = y1;
+            ay = x1;
+            bx = y2;
+            by = x2;
         }
-        if (dy < 0)
+        if (ax > bx)
         {
-            dy = -dy;
-            sy = -1;
+            int32_t t = ax;
+            ax = bx;
+            bx = t;
+            t = ay;
+            ay = by;
+            by = t;
         }
-        dy = -dy;
-        int16_t e = dx + dy;
-        int16_t de;
-        for (;;)
+        int32_t major_min = steep ? d->clip_y1 : d->clip_x1;
+        int32_t major_max = steep ? d->clip_y2 : d->clip_x2;
+        int32_t minor_min = steep ? d->clip_x1 : d->clip_y1;
+        int32_t minor_max = steep ? d->clip_x2 : d->clip_y2;
+        int32_t m = ax < major_min ? major_min : ax;
+        int32_t end = bx > major_max ? major_max : bx;
+        bool entered = false;
+        SSD1306_Edge edge;
+        ssd1306_edge_init(&edge, ax, ay, bx, by, m);
+        for (; m <= end; m++, ssd1306_edge_step(&edge))
         {
-            ssd1306_put_pixel(d, (uint8_t)x1, (uint8_t)y1);
-            de = 2 * e;
-            if (de >= dy)
+            if (edge.y >= minor_min && edge.y <= minor_max)
             {
-                if (x1 == x2)
-                    break;
-                e += dy;
-                x1 += sx;
-            }
-            if (de <= dx)
-            {
-                if (y1 == y2)
-                    break;
-                e += dx;
-                y1 += sy;
+                if (steep)
+                    ssd1306_plot_pixel(d, edge.y, m);
+                else
+                    ssd1306_plot_pixel(d, m, edge.y);
+                entered = true;
             }
+            else if (entered)
+                break;
         }
     }
 }
 
-void ssd1306_draw_ellipse(SSD1306_Display *d, int8_t cx, int8_t cy, int8_t a, int8_t b)
+/**
+ * Plots a pixel of a shape quadrant, checking the clip rectangle only when the quadrant
+ * crosses it
+ * @param d pointer to SSD1306_Display
+ * @param quadrant SSD1306_CLIP_* class of the quadrant
+ */
+static inline void ssd1306_plot_quadrant(SSD1306_Display *d, uint8_t quadrant, int32_t x, int32_t y)
 {
+    if (quadrant == SSD1306_CLIP_INSIDE ||
+        (quadrant == SSD1306_CLIP_PARTIAL && x >= d->clip_x1 && x <= d->clip_x2 && y >= d->clip_y1 && y <= d->clip_y2))
+        ssd1306_plot_pixel(d, x, y);
+}
+
+void ssd1306_draw_ellipse(SSD1306_Display *d, int16_t cx, int16_t cy, int16_t a, int16_t b)
+{
+    if (a < 0 || b < 0)
+        return;
+    uint8_t right_bottom = ssd1306_classify(d, cx, cy, cx + a, cy + b);
+    uint8_t left_bottom = ssd1306_classify(d, cx - a, cy, cx, cy + b);
+    uint8_t left_top = ssd1306_classify(d, cx - a, cy - b, cx, cy);
+    uint8_t right_top = ssd1306_classify(d, cx, cy - b, cx + a, cy);
+    if ((right_bottom | left_bottom | left_top | right_top) == SSD1306_CLIP_OUTSIDE)
+        return;
     int32_t x = -a;
     int32_t y = 0;
-    int32_t de = b;
-    int32_t dx = (1 + 2 * x) * de * de;
-    int32_t dy = x * x;
-    int32_t e = dx + dy;
+    int64_t de;
+    int64_t dx = (1 + 2 * x) * (int64_t)b * b;
+    int64_t dy = (int64_t)x * x;
+    int64_t e = dx + dy;
     do
     {
-        ssd1306_put_pixel(d, cx - x, cy + y);
-        ssd1306_put_pixel(d, cx + x, cy + y);
-        ssd1306_put_pixel(d, cx + x, cy - y);
-        ssd1306_put_pixel(d, cx - x, cy - y);
+        /* Plot each pixel once on the axes, so the XOR mode does not cancel them */
+        ssd1306_plot_quadrant(d, right_bottom, cx - x, cy + y);
+        if (x != 0)
+            ssd1306_plot_quadrant(d, left_bottom, cx + x, cy + y);
+        if (y != 0)
+        {
+            ssd1306_plot_quadrant(d, left_top, cx + x, cy - y);
+            if (x != 0)
+                ssd1306_plot_quadrant(d, right_top, cx - x, cy - y);
+        }
         de = 2 * e;
         if (de >= dx)
         {
             x++;
-            e += dx += 2 * b * b;
+            e += dx += 2 * (int64_t)b * b;
         }
         if (de <= dy)
         {
             y++;
-            e += dy += 2 * a * a;
+            e += dy += 2 * (int64_t)a * a;
         }
     } while (x <= 0);
     while (y++ < b)
     {
-        ssd1306_put_pixel(d, cx, cy + y);
-        ssd1306_put_pixel(d, cx, cy - y);
+        ssd1306_plot_quadrant(d, right_bottom, cx, cy + y);
+        ssd1306_plot_quadrant(d, right_top, cx, cy - y);
     }
 }
 
-void ssd1306_draw_circle(SSD1306_Display *d, int8_t cx, int8_t cy, int8_t r)
+void ssd1306_draw_circle(SSD1306_Display *d, int16_t cx, int16_t cy, int16_t r)
 {
-    int16_t x = -r;
-    int16_t y = 0;
-    int16_t e = 2 - 2 * r;
+    if (r <= 0)
+    {
+        if (r == 0)
+            ssd1306_put_pixel(d, cx, cy);
+        return;
+    }
+    uint8_t right_bottom = ssd1306_classify(d, cx, cy, cx + r, cy + r);
+    uint8_t left_bottom = ssd1306_classify(d, cx - r, cy, cx, cy + r);
+    uint8_t left_top = ssd1306_classify(d, cx - r, cy - r, cx, cy);
+    uint8_t right_top = ssd1306_classify(d, cx, cy - r, cx + r, cy);
+    if ((right_bottom | left_bottom | left_top | right_top) == SSD1306_CLIP_OUTSIDE)
+        return;
+    int32_t x = -r;
+    int32_t y = 0;
+    int32_t e = 2 - 2 * r;
+    int32_t t;
     do
     {
-        ssd1306_put_pixel(d, cx - x, cy + y);
-        ssd1306_put_pixel(d, cx - y, cy - x);
-        ssd1306_put_pixel(d, cx + x, cy - y);
-        ssd1306_put_pixel(d, cx + y, cy + x);
-        r = e;
-        if (r <= y)
+        ssd1306_plot_quadrant(d, right_bottom, cx - x, cy + y);
+        ssd1306_plot_quadrant(d, left_bottom, cx - y, cy - x);
+        ssd1306_plot_quadrant(d, left_top, cx + x, cy - y);
+        ssd1306_plot_quadrant(d, right_top, cx + y, cy + x);
+        t = e;
+        if (t <= y)
             e += ++y * 2 + 1;
-        if (r > x || e > y)
+        if (t > x || e > y)
             e += ++x * 2 + 1;
     } while (x < 0);
 }
 
-void ssd1306_set_font(SSD1306_Display *d, SSD1306_Font *f)
+/**
+ * Raises the half height of a filled shape column, columns outside the clip rectangle are ignored
+ * @param d pointer to SSD1306_Display
+ * @param heights half height of each display column, -1 for empty columns
+ */
+static inline void ssd1306_raise_height(const SSD1306_Display *d, int32_t *heights, int32_t column, int32_t height)
 {
-    d->font = f;
-    ssd1306_set_cursor(d, 0, 0);
+    if (column >= d->clip_x1 && column <= d->clip_x2 && heights[column] < height)
+        heights[column] = height;
 }
 
-void ssd1306_set_cursor(SSD1306_Display *d, uint8_t c, uint8_t r)
+/**
+ * Fills the columns of a shape, from row top - heights[c] to row bottom + heights[c]
+ * @param d pointer to SSD1306_Display
+ * @param heights half height of each display column, -1 for empty columns
+ */
+static void ssd1306_fill_heights(SSD1306_Display *d, const int32_t *heights, int32_t top, int32_t bottom)
 {
-    if (r > (d->pages - d->font->character_height))
-        r = d->pages - d->font->character_height;
-    if (c > d->max_x)
-        c = 0;
-    d->cursor_position = 1 + c + r * d->width;
-    d->line_limit = d->width * (r + 1);
+    for (int32_t c = d->clip_x1; c <= d->clip_x2; c++)
+    {
+        if (heights[c] >= 0)
+            ssd1306_fill_column(d, c, top - heights[c], bottom + heights[c]);
+    }
 }
 
-void ssd1306_print(SSD1306_Display *d, const char *text)
+/**
+ * Runs the ssd1306_draw_circle midpoint algorithm and keeps the largest row offset of the
+ * outline for each column, the left half of the circle centered on column left, the right
+ * half on column right and the columns in between r rows high
+ * @param d pointer to SSD1306_Display
+ * @param r radius
+ * @param heights half height of each display column, -1 for empty columns
+ */
+static void ssd1306_circle_heights(const SSD1306_Display *d, int32_t r, int32_t left, int32_t right, int32_t *heights)
 {
-    uint32_t i = 0;
-    while (*(text + i))
+    for (int32_t c = d->clip_x1; c <= d->clip_x2; c++)
+        heights[c] = c > left && c < right ? r : -1;
+    int32_t x = -r;
+    int32_t y = 0;
+    int32_t e = 2 - 2 * r;
+    int32_t t;
+    do
+    {
+        ssd1306_raise_height(d, heights, right - x, y);
+        ssd1306_raise_height(d, heights, left + x, y);
+        ssd1306_raise_height(d, heights, right + y, -x);
+        ssd1306_raise_height(d, heights, left - y, -x);
+        t = e;
+        if (t <= y)
+            e += ++y * 2 + 1;
+        if (t > x || e > y)
+            e += ++x * 2 + 1;
+    } while (x < 0);
+}
+
+void ssd1306_fill_circle(SSD1306_Display *d, int16_t cx, int16_t cy, int16_t r)
+{
+    if (r < 0 || ssd1306_classify(d, cx - r, cy - r, cx + r, cy + r) == SSD1306_CLIP_OUTSIDE)
+        return;
+    int32_t heights[SSD1306_MAX_WIDTH];
+    ssd1306_circle_heights(d, r, cx, cx, heights);
+    ssd1306_fill_heights(d, heights, cy, cy);
+}
+
+void ssd1306_fill_ellipse(SSD1306_Display *d, int16_t cx, int16_t cy, int16_t a, int16_t b)
+{
+    if (a < 0 || b < 0 || ssd1306_classify(d, cx - a, cy - b, cx + a, cy + b) == SSD1306_CLIP_OUTSIDE)
+        return;
+    int32_t heights[SSD1306_MAX_WIDTH];
+    for (int32_t c = d->clip_x1; c <= d->clip_x2; c++)
+        heights[c] = -1;
+    int32_t x = -a;
+    int32_t y = 0;
+    int64_t de;
+    int64_t dx = (1 + 2 * x) * (int64_t)b * b;
+    int64_t dy = (int64_t)x * x;
+    int64_t e = dx + dy;
+    do
     {
-        uint32_t character = text[i] - d->font->first_character;
-        if (character > (d->font->last_character - d->font->first_character))
+        ssd1306_raise_height(d, heights, cx - x, y);
+        ssd1306_raise_height(d, heights, cx + x, y);
+        de = 2 * e;
+        if (de >= dx)
         {
-            character = d->font->overflow_character - d->font->first_character;
+            x++;
+            e += dx += 2 * (int64_t)b * b;
         }
-        uint8_t char_width = d->font->character_width[character];
-        if ((d->cursor_position + char_width) > d->line_limit)
+        if (de <= dy)
         {
-            uint8_t p = d->line_limit / d->width;
-            if (p == d->pages - 1)
-                break;
-            else
-                ssd1306_set_cursor(d, 0, (p + (d->font)->character_height) - 1);
+            y++;
+            e += dy += 2 * (int64_t)a * a;
+        }
+    } while (x <= 0);
+    ssd1306_raise_height(d, heights, cx, b);
+    ssd1306_fill_heights(d, heights, cy, cy);
+}
+
+void ssd1306_draw_triangle(SSD1306_Display *d, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3)
+{
+    ssd1306_draw_line(d, x1, y1, x2, y2);
+    ssd1306_draw_line(d, x2, y2, x3, y3);
+    ssd1306_draw_line(d, x3, y3, x1, y1);
+}
+
+/**
+ * Widens the row span of a column to a pixel of a shape outline, columns outside the clip
+ * rectangle are ignored and rows are clamped to one row beyond it
+ * @param d pointer to SSD1306_Display
+ * @param tops first row of each display column, bottoms last one, empty when tops > bottoms
+ */
+static inline void ssd1306_widen_span(const SSD1306_Display *d, int16_t *tops, int16_t *bottoms, int32_t column, int32_t row)
+{
+    if (column < d->clip_x1 || column > d->clip_x2)
+        return;
+    if (row < d->clip_y1 - 1)
+        row = d->clip_y1 - 1;
+    else if (row > d->clip_y2 + 1)
+        row = d->clip_y2 + 1;
+    if (row < tops[column])
+        tops[column] = row;
+    if (row > bottoms[column])
+        bottoms[column] = row;
+}
+
+/**
+ * Widens the row spans of the columns c1 to c2, in any order, to the same row
+ * @param d pointer to SSD1306_Display
+ * @param tops first row of each display column, bottoms last one, empty when tops > bottoms
+ */
+static void ssd1306_widen_spans(const SSD1306_Display *d, int16_t *tops, int16_t *bottoms, int32_t c1, int32_t c2, int32_t row)
+{
+    int32_t c = c1 < c2 ? c1 : c2;
+    int32_t end = c1 < c2 ? c2 : c1;
+    if (c < d->clip_x1)
+        c = d->clip_x1;
+    if (end > d->clip_x2)
+        end = d->clip_x2;
+    for (; c <= end; c++)
+        ssd1306_widen_span(d, tops, bottoms, c, row);
+}
+
+/**
+ * Widens the row spans of the columns to every pixel ssd1306_draw_line draws from (x1, y1)
+ * to (x2, y2). Steep lines are walked by rows around the clip rectangle only: the rows above
+ * or below it clamp to the same row, so their columns are widened together
+ * @param d pointer to SSD1306_Display
+ * @param tops first row of each display column, bottoms last one, empty when tops > bottoms
+ */
+static void ssd1306_line_spans(const SSD1306_Display *d, int16_t *tops, int16_t *bottoms, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    int32_t t;
+    SSD1306_Edge edge;
+    if ((y1 < y2 ? y2 - y1 : y1 - y2) <= (x1 < x2 ? x2 - x1 : x1 - x2))
+    {
+        if (x1 > x2)
+        {
+            t = x1;
+            x1 = x2;
+            x2 = t;
+            t = y1;
+            y1 = y2;
+            y2 = t;
+        }
+        if (x1 == x2)
+        {
+            ssd1306_widen_span(d, tops, bottoms, x1, y1);
+            return;
+        }
+        int32_t c = x1 < d->clip_x1 ? d->clip_x1 : x1;
+        int32_t end = x2 > d->clip_x2 ? d->clip_x2 : x2;
+        if (c > end)
+            return;
+        /* One pixel per column, the columns are inside the clip rectangle */
+        int32_t above = d->clip_y1 - 1, below = d->clip_y2 + 1;
+        ssd1306_edge_init(&edge, x1, y1, x2, y2, c);
+        for (; c <= end; c++, ssd1306_edge_step(&edge))
+        {
+            int16_t row = edge.y < above ? above : (edge.y > below ? below : edge.y);
+            if (row < tops[c])
+                tops[c] = row;
+            if (row > bottoms[c])
+                bottoms[c] = row;
         }
-        for (int j = 0; j < char_width; j++)
+        return;
+    }
+    if (y1 > y2)
+    {
+        t = x1;
+        x1 = x2;
+        x2 = t;
+        t = y1;
+        y1 = y2;
+        y2 = t;
+    }
+    int32_t r = y1 < d->clip_y1 - 1 ? d->clip_y1 - 1 : y1;
+    int32_t end = y2 > d->clip_y2 + 1 ? d->clip_y2 + 1 : y2;
+    if (r > end)
+    {
+        ssd1306_widen_spans(d, tops, bottoms, x1, x2, y1);
+        return;
+    }
+    ssd1306_edge_init(&edge, y1, x1, y2, x2, r);
+    ssd1306_widen_spans(d, tops, bottoms, x1, edge.y, r);
+    for (; r <= end; r++, ssd1306_edge_step(&edge))
+    {
+        ssd1306_widen_span(d, tops, bottoms, edge.y, r);
+        t = edge.y;
+    }
+    ssd1306_widen_spans(d, tops, bottoms, t, x2, end);
+}
+
+void ssd1306_fill_triangle(SSD1306_Display *d, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3)
+{
+    int32_t left = x1 < x2 ? (x1 < x3 ? x1 : x3) : (x2 < x3 ? x2 : x3);
+    int32_t right = x1 > x2 ? (x1 > x3 ? x1 : x3) : (x2 > x3 ? x2 : x3);
+    int32_t top = y1 < y2 ? (y1 < y3 ? y1 : y3) : (y2 < y3 ? y2 : y3);
+    int32_t bottom = y1 > y2 ? (y1 > y3 ? y1 : y3) : (y2 > y3 ? y2 : y3);
+    if (ssd1306_classify(d, left, top, right, bottom) == SSD1306_CLIP_OUTSIDE)
+        return;
+    /* A triangle is convex: each column is filled between the first and the last pixel of the
+     * ssd1306_draw_triangle outline, so steep edges leave no gaps and the outline is covered */
+    int16_t tops[SSD1306_MAX_WIDTH];
+    int16_t bottoms[SSD1306_MAX_WIDTH];
+    for (int32_t c = d->clip_x1; c <= d->clip_x2; c++)
+    {
+        tops[c] = INT16_MAX;
+        bottoms[c] = INT16_MIN;
+    }
+    ssd1306_line_spans(d, tops, bottoms, x1, y1, x2, y2);
+    ssd1306_line_spans(d, tops, bottoms, x2, y2, x3, y3);
+    ssd1306_line_spans(d, tops, bottoms, x3, y3, x1, y1);
+    for (int32_t c = d->clip_x1; c <= d->clip_x2; c++)
+    {
+        if (tops[c] <= bottoms[c])
+            ssd1306_fill_column(d, c, tops[c], bottoms[c]);
+    }
+}
+
+void ssd1306_fill_rounded_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height, int16_t r)
+{
+    if (width <= 0 || height <= 0)
+        return;
+    int32_t x2 = (int32_t)x + width - 1;
+    int32_t y2 = (int32_t)y + height - 1;
+    if (ssd1306_classify(d, x, y, x2, y2) == SSD1306_CLIP_OUTSIDE)
+        return;
+    int16_t shortest = width < height ? width : height;
+    if (r > (shortest - 1) / 2)
+        r = (shortest - 1) / 2;
+    if (r < 0)
+        r = 0;
+    int32_t heights[SSD1306_MAX_WIDTH];
+    ssd1306_circle_heights(d, r, x + r, x2 - r, heights);
+    ssd1306_fill_heights(d, heights, y + r, y2 - r);
+}
+
+/**
+ * Loads page p of a bitmap column, with the mask limited to the bitmap height
+ * @param b bitmap
+ * @param page bitmap page, out of range pages are empty
+ * @param column bitmap column
+ * @param mask set to the drawn pixels
+ * @return bitmap byte
+ */
+static inline uint8_t ssd1306_bitmap_byte(const SSD1306_Bitmap *b, int16_t page, uint8_t column, uint8_t *mask)
+{
+    int16_t rows = b->height - page * 8;
+    if (page < 0 || rows <= 0)
+    {
+        *mask = 0x00;
+        return 0x00;
+    }
+    uint32_t index = column + page * b->stride;
+    uint8_t valid = rows >= 8 ? 0xFF : (1 << rows) - 1;
+    *mask = b->mask != NULL ? b->mask[index] & valid : valid;
+    return b->data[index];
+}
+
+#ifdef SSD1306_ENABLE_STATS
+/**
+ * Counts the set bits of a byte
+ */
+static inline uint8_t ssd1306_count_bits(uint8_t b)
+{
+    b = b - ((b >> 1) & 0x55);
+    b = (b & 0x33) + ((b >> 2) & 0x33);
+    return (b + (b >> 4)) & 0x0F;
+}
+#endif
+
+void ssd1306_draw_bitmap(SSD1306_Display *d, const SSD1306_Bitmap *b, int16_t x, int16_t y, uint8_t mode)
+{
+    /* b = (b & ~(m & clear)) ^ (m & toggle), clear and toggle taken from the source byte s:
+     * clear = (s & clear_source) | clear_fill, toggle = s & toggle_source */
+    static const uint8_t clear_source[4] = {0xFF, 0xFF, 0x00, 0x00};
+    static const uint8_t clear_fill[4] = {0x00, 0x00, 0x00, 0xFF};
+    static const uint8_t toggle_source[4] = {0xFF, 0x00, 0xFF, 0xFF};
+    if (mode > SSD1306_BLIT_COPY || b->width == 0 || b->height == 0)
+        return;
+    int32_t x1 = x, y1 = y, x2 = (int32_t)x + b->width - 1, y2 = (int32_t)y + b->height - 1;
+    if (!ssd1306_intersect(&x1, &y1, &x2, &y2, d->clip_x1, d->clip_y1, d->clip_x2, d->clip_y2))
+        return;
+    int32_t top_page = y >= 0 ? y >> 3 : -((7 - y) >> 3);
+    uint8_t shift = y - top_page * 8;
+    for (uint8_t page = y1 >> 3; page <= y2 >> 3; page++)
+    {
+        /* Frame page p takes the low bits of bitmap page i and the high bits of page i - 1 */
+        int32_t i = page - top_page;
+        uint8_t rows = ssd1306_page_mask(page, y1, y2);
+        uint8_t *p = d->frame + 1 + page * SSD1306_WIDTH(d);
+        int32_t first = x2 + 1, last = x1 - 1;
+        for (int32_t c = x1; c <= x2; c++)
         {
-            uint32_t offset = (d->font)->character_offset[character] + j;
-            d->frame[d->cursor_position + j] |= (d->font)->font_array[offset];
-            uint32_t vertical_index = d->cursor_position + d->width + j;
-            for (int k = 0; k < ((d->font)->character_height - 1); k++)
+            uint8_t high_mask, low_mask;
+            uint8_t high = ssd1306_bitmap_byte(b, i - 1, c - x, &high_mask);
+            uint8_t low = ssd1306_bitmap_byte(b, i, c - x, &low_mask);
+            uint8_t s = (uint8_t)((((uint16_t)low << 8) | high) << shift >> 8);
+            uint8_t m = (uint8_t)((((uint16_t)low_mask << 8) | high_mask) << shift >> 8) & rows;
+            uint8_t clear = (s & clear_source[mode]) | clear_fill[mode];
+            uint8_t value = (p[c] & ~(m & clear)) ^ (m & s & toggle_source[mode]);
+            if (value != p[c])
             {
-                d->frame[vertical_index] |= (d->font)->font_array[(d->font)->vertical_offsets[k] + offset];
-                vertical_index += d->width;
+                SSD1306_STATS_ADD(d, pixels, ssd1306_count_bits(value ^ p[c]));
+                p[c] = value;
+                if (first > x2)
+                    first = c;
+                last = c;
             }
         }
-        d->cursor_position += char_width + d->font->character_spacing;
-        i++;
+        if (first <= last)
+            ssd1306_mark_dirty(d, page, first, last);
     }
 }
 
-void ssd1306_println(SSD1306_Display *d, const char *text)
+/**
+ * Decodes the next UTF-8 character of a text and moves the text past it. Malformed,
+ * overlong and surrogate sequences decode to U+FFFD
+ * @param text text, not at its terminator
+ */
+static inline uint32_t ssd1306_utf8_next(const char **text)
 {
-    uint32_t i = 0;
-    while (*(text + i))
+    const uint8_t *s = (const uint8_t *)*text;
+    uint32_t c = s[0];
+    if (c < 0x80)
+    {
+        *text += 1;
+        return c;
+    }
+    static const uint32_t minimum[4] = {0, 0x80, 0x800, 0x10000};
+    uint32_t n;
+    if ((c & 0xe0) == 0xc0)
+        n = 1, c &= 0x1f;
+    else if ((c & 0xf0) == 0xe0)
+        n = 2, c &= 0x0f;
+    else if ((c & 0xf8) == 0xf0)
+        n = 3, c &= 0x07;
+    else
+    {
+        *text += 1;
+        return 0xfffd;
+    }
+    for (uint32_t i = 1; i <= n; i++)
     {
-        uint32_t character = text[i] - d->font->first_character;
-        if (character > (d->font->last_character - d->font->first_character))
+        /* The terminator is not a continuation byte, so a truncated sequence stops on it */
+        if ((s[i] & 0xc0) != 0x80)
         {
-            character = d->font->overflow_character - d->font->first_character;
+            *text += i;
+            return 0xfffd;
         }
-        uint8_t char_width = d->font->character_width[character];
-        if ((d->cursor_position + char_width) > d->line_limit)
-        {
+        c = (c << 6) | (s[i] & 0x3f);
+    }
+    *text += n + 1;
+    if (c < minimum[n] || c > 0x10ffff || (c >= 0xd800 && c <= 0xdfff))
+        return 0xfffd;
+    return c;
+}
+
+/**
+ * Index of a character in the font tables, the overflow character for characters out of the font.
+ * Characters of the contiguous range are found in constant time, the others by binary search
+ * @param f font
+ * @param c Unicode codepoint
+ */
+static inline uint32_t ssd1306_glyph_index(const SSD1306_Font *f, uint32_t c)
+{
+    uint8_t first = f->first_character;
+    uint32_t count = (uint8_t)f->last_character - first + 1;
+    uint32_t character = c - first;
+    if (character < count)
+        return character;
+    uint32_t low = 0, high = f->codepoint_count;
+    while (low < high)
+    {
+        uint32_t middle = (low + high) >> 1;
+        if (f->codepoints[middle] < c)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low < f->codepoint_count && f->codepoints[low] == c)
+        return count + low;
+    return (uint8_t)f->overflow_character - first;
+}
+
+/**
+ * Decoder of the runs of a SSD1306_FONT_RLE glyph
+ */
+typedef struct ssd1306_rle
+{
+    const uint8_t *source;
+    /** Bytes left in the current run */
+    uint8_t count;
+    uint8_t value;
+    bool literal;
+} SSD1306_Rle;
+
+/**
+ * Next byte of a SSD1306_FONT_RLE glyph
+ * @param r decoder
+ */
+static inline uint8_t ssd1306_rle_next(SSD1306_Rle *r)
+{
+    if (r->count == 0)
+    {
+        uint8_t token = *r->source++;
+        r->literal = (token & 0x80) == 0;
+        r->count = (token & (r->literal ? 0x7f : 0x3f)) + 1;
+        r->value = (token & 0xc0) == 0xc0 ? *r->source++ : 0x00;
+    }
+    r->count--;
+    return r->literal ? *r->source++ : r->value;
+}
+
+/**
+ * Draws a glyph of a SSD1306_FONT_RLE font with its top left corner at (x, y), decoding its
+ * runs straight into the frame
+ * @param d pointer to SSD1306_Display
+ * @param character index of the glyph in the font tables
+ * @param x1 left column of the glyph inside the clip rectangle, likewise y1, x2 and y2
+ */
+static void ssd1306_draw_rle_glyph(SSD1306_Display *d, uint32_t character, int16_t x, int16_t y, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    const SSD1306_Font *f = d->font;
+    uint8_t width = f->character_width[character];
+    SSD1306_Rle r = {.source = f->font_array + f->character_offset[character]};
+    int32_t top_page = y >= 0 ? y >> 3 : -((7 - y) >> 3);
+    uint8_t shift = y - top_page * 8;
+    for (uint8_t k = 0; k < f->character_height; k++)
+    {
+        int32_t page = top_page + k;
+        if (page > (y2 >> 3))
             break;
+        /* Glyph page k covers the low bits of frame page top_page + k and, when shifted,
+         * the high bits of the next one */
+        uint8_t low = page >= (y1 >> 3) ? ssd1306_page_mask(page, y1, y2) : 0;
+        uint8_t high = shift && page + 1 >= (y1 >> 3) && page + 1 <= (y2 >> 3) ? ssd1306_page_mask(page + 1, y1, y2) : 0;
+        uint8_t *p = low ? d->frame + 1 + page * SSD1306_WIDTH(d) : NULL;
+        uint8_t *q = high ? d->frame + 1 + (page + 1) * SSD1306_WIDTH(d) : NULL;
+        uint8_t low_clear = low & d->draw_clear, low_toggle = low & d->draw_toggle;
+        uint8_t high_clear = high & d->draw_clear, high_toggle = high & d->draw_toggle;
+        for (uint8_t j = 0; j < width; j++)
+        {
+            uint16_t bits = (uint16_t)ssd1306_rle_next(&r) << shift;
+            int32_t c = x + j;
+            if (c < x1 || c > x2)
+                continue;
+            if (p != NULL)
+                p[c] = (p[c] & ~(bits & low_clear)) ^ (bits & low_toggle);
+            if (q != NULL)
+                q[c] = (q[c] & ~((bits >> 8) & high_clear)) ^ ((bits >> 8) & high_toggle);
         }
-        for (int j = 0; j < char_width; j++)
+        if (p != NULL)
+            ssd1306_mark_dirty(d, page, x1, x2);
+        if (q != NULL)
+            ssd1306_mark_dirty(d, page + 1, x1, x2);
+    }
+}
+
+/**
+ * Copies the unclipped raw glyphs of a line onto page aligned frame bytes following the draw
+ * mode. Always inlined so that callers passing a constant height get the page loop of each
+ * column unrolled, with the glyph page offsets and the frame stride held in registers
+ * @param p frame byte under the top left corner of the first glyph
+ * @param stride frame bytes between two pages
+ * @param glyphs font indexes of the line
+ * @param n number of glyphs
+ * @param height font height in pages, at most SSD1306_MAX_PAGES as the glyphs are unclipped
+ */
+static inline __attribute__((__always_inline__)) void ssd1306_copy_glyphs(uint8_t *p, uint32_t stride, const SSD1306_Font *f, const uint16_t *glyphs, uint32_t n, uint8_t height, uint8_t clear, uint8_t toggle)
+{
+    uint32_t offsets[SSD1306_MAX_PAGES];
+    for (uint8_t k = 0; k < height; k++)
+        offsets[k] = k ? f->vertical_offsets[k - 1] : 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const uint8_t *glyph = f->font_array + f->character_offset[glyphs[i]];
+        uint8_t width = f->character_width[glyphs[i]];
+        for (uint8_t j = 0; j < width; j++, p++)
         {
-            uint32_t offset = (d->font)->character_offset[character] + j;
-            d->frame[d->cursor_position + j] |= (d->font)->font_array[offset];
-            uint32_t vertical_index = d->cursor_position + d->width + j;
-            for (int k = 0; k < ((d->font)->character_height - 1); k++)
+            for (uint8_t k = 0; k < height; k++)
             {
-                d->frame[vertical_index] |= (d->font)->font_array[(d->font)->vertical_offsets[k] + offset];
-                vertical_index += d->width;
+                uint8_t bits = glyph[offsets[k] + j];
+                p[k * stride] = (p[k * stride] & ~(bits & clear)) ^ (bits & toggle);
             }
         }
-        d->cursor_position += char_width + d->font->character_spacing;
-        i++;
+        p += f->character_spacing;
     }
-    uint8_t p = d->line_limit / d->width;
-    if (p != d->pages - 1)
+}
+
+/**
+ * Draws a line of glyphs of a raw font on a page boundary and inside the clip rectangle: the
+ * glyphs are copied in place, with the page count a constant for the heights of the library
+ * fonts, and each page of the line is marked dirty once
+ * @param d pointer to SSD1306_Display
+ * @param glyphs font indexes of the line
+ * @param n number of glyphs
+ * @param x left column of the line
+ * @param right last column of the line
+ */
+static void ssd1306_draw_glyph_line(SSD1306_Display *d, const uint16_t *glyphs, uint32_t n, int32_t x, int32_t y, int32_t right)
+{
+    const SSD1306_Font *f = d->font;
+    uint8_t height = f->character_height;
+    uint8_t page = y >> 3;
+    uint32_t stride = SSD1306_WIDTH(d);
+    uint8_t *p = d->frame + 1 + x + page * stride;
+    switch (height)
     {
-        ssd1306_set_cursor(d, 0, (p + (d->font)->character_height) - 1);
+    case 1:
+        ssd1306_copy_glyphs(p, stride, f, glyphs, n, 1, d->draw_clear, d->draw_toggle);
+        break;
+    case 2:
+        ssd1306_copy_glyphs(p, stride, f, glyphs, n, 2, d->draw_clear, d->draw_toggle);
+        break;
+    default:
+        ssd1306_copy_glyphs(p, stride, f, glyphs, n, height, d->draw_clear, d->draw_toggle);
+        break;
     }
+    if (right >= x)
+        for (uint8_t k = 0; k < height; k++)
+            ssd1306_mark_dirty(d, page + k, x, right);
+    SSD1306_STATS_ADD(d, glyphs, n);
 }
 
-void ssd1306_print_aligned(SSD1306_Display *d, const char *text, uint8_t a)
+/**
+ * Draws a glyph of the display font with its top left corner at (x, y), following the draw mode
+ * and clipped to the clip rectangle. Each glyph byte is split across two frame pages when y is
+ * not a multiple of 8, unclipped glyphs on a page boundary are copied in place
+ * @param d pointer to SSD1306_Display
+ * @param character index of the glyph in the font tables
+ */
+static void ssd1306_draw_glyph(SSD1306_Display *d, uint32_t character, int16_t x, int16_t y)
 {
-    uint32_t i = 0;
-    uint32_t text_width = 0;
-    while (*(text + i))
+    const SSD1306_Font *f = d->font;
+    uint8_t width = f->character_width[character];
+    int32_t x1 = x, y1 = y, x2 = (int32_t)x + width - 1, y2 = (int32_t)y + f->character_height * 8 - 1;
+    SSD1306_STATS_ADD(d, glyphs, 1);
+    if (width == 0 || !ssd1306_intersect(&x1, &y1, &x2, &y2, d->clip_x1, d->clip_y1, d->clip_x2, d->clip_y2))
+        return;
+    if (f->encoding == SSD1306_FONT_RLE)
     {
-        uint32_t character = text[i] - d->font->first_character;
-        if (character > (d->font->last_character - d->font->first_character))
+        ssd1306_draw_rle_glyph(d, character, x, y, x1, y1, x2, y2);
+        return;
+    }
+    if ((y & 7) == 0 && x1 == x && y1 == y && x2 - x1 + 1 == width && y2 - y1 + 1 == f->character_height * 8)
+    {
+        /* Aligned and unclipped: copy the glyph pages in place */
+        uint8_t clear = d->draw_clear;
+        uint8_t toggle = d->draw_toggle;
+        uint8_t page = y >> 3;
+        uint8_t *p = d->frame + 1 + x + page * SSD1306_WIDTH(d);
+        for (uint8_t k = 0; k < f->character_height; k++, page++, p += SSD1306_WIDTH(d))
         {
-            character = d->font->overflow_character - d->font->first_character;
+            const uint8_t *source = f->font_array + (k ? f->vertical_offsets[k - 1] : 0) + f->character_offset[character];
+            for (uint8_t j = 0; j < width; j++)
+                p[j] = (p[j] & ~(source[j] & clear)) ^ (source[j] & toggle);
+            ssd1306_mark_dirty(d, page, x, x2);
         }
-        text_width += d->font->character_width[character];
-        text_width += d->font->character_spacing;
-        i++;
+        return;
     }
-    text_width -= d->font->character_spacing;
-    uint8_t c = 0;
-    uint8_t r = d->line_limit / d->width;
-    if (text_width < d->width)
+    int32_t top_page = y >= 0 ? y >> 3 : -((7 - y) >> 3);
+    uint8_t shift = y - top_page * 8;
+    for (uint8_t k = 0; k < f->character_height; k++)
     {
-        switch (a)
+        const uint8_t *column = f->font_array + (k ? f->vertical_offsets[k - 1] : 0) + f->character_offset[character];
+        /* Glyph page k covers the low bits of frame page top_page + k and, when shifted,
+         * the high bits of the next one */
+        for (uint8_t half = 0; half < (shift ? 2 : 1); half++)
         {
-        case SSD1306_TEXT_CENTER:
-            c = (d->max_x - text_width) >> 1;
-            break;
-        case SSD1306_TEXT_RIGHT:
-            c = d->max_x - text_width;
-        default:
-            break;
+            int32_t page = top_page + k + half;
+            if (page < (y1 >> 3) || page > (y2 >> 3))
+                continue;
+            uint8_t rows = ssd1306_page_mask(page, y1, y2);
+            uint8_t clear = rows & d->draw_clear;
+            uint8_t toggle = rows & d->draw_toggle;
+            uint8_t *p = d->frame + 1 + page * SSD1306_WIDTH(d);
+            const uint8_t *source = column + (x1 - x);
+            uint8_t high = half * 8;
+            for (int32_t c = x1; c <= x2; c++, source++)
+            {
+                uint8_t bits = (uint8_t)(((uint16_t)*source << shift) >> high);
+                p[c] = (p[c] & ~(bits & clear)) ^ (bits & toggle);
+            }
+            ssd1306_mark_dirty(d, page, x1, x2);
+        }
+    }
+}
+
+void ssd1306_set_font(SSD1306_Display *d, const SSD1306_Font *f)
+{
+    d->font = f;
+    ssd1306_set_cursor(d, 0, 0);
+}
+
+void ssd1306_set_cursor(SSD1306_Display *d, uint8_t c, uint8_t r)
+{
+    /* Negative when the font is taller than the display, the text then starts on the first page */
+    int16_t last_row = (int16_t)SSD1306_PAGES(d) - d->font->character_height;
+    if (r > last_row)
+        r = last_row < 0 ? 0 : last_row;
+    if (c > d->max_x)
+        c = 0;
+    d->cursor_x = c;
+    d->cursor_y = r * 8;
+}
+
+void ssd1306_set_cursor_xy(SSD1306_Display *d, int16_t x, int16_t y)
+{
+    d->cursor_x = x;
+    d->cursor_y = y;
+}
+
+/**
+ * Maximum glyphs held by the layout for one line, a line this long is broken regardless of its width
+ */
+#define SSD1306_LAYOUT_GLYPHS SSD1306_MAX_WIDTH
+
+/**
+ * Text layout state shared by the print functions and ssd1306_measure_text
+ */
+typedef struct ssd1306_layout
+{
+    /** Box columns, lines wrap at word boundaries when width is positive */
+    int32_t left;
+    int32_t width;
+    /** First row below the box, only lines that fit above it follow the first one */
+    int32_t bottom;
+    /** Top left corner of the current line, may be indented from the box left */
+    int32_t x;
+    int32_t y;
+    uint8_t align;
+    bool draw;
+    /** Width of the widest line and number of lines laid out */
+    int32_t widest;
+    uint32_t lines;
+} SSD1306_Layout;
+
+/**
+ * Aligns a line in the box, draws its glyphs and leaves the layout x after them
+ * @param d pointer to SSD1306_Display
+ * @param glyphs font indexes of the line
+ * @param n number of glyphs
+ * @param ink width of the line without its trailing spaces
+ */
+static void ssd1306_layout_line(SSD1306_Display *d, SSD1306_Layout *l, const uint16_t *glyphs, uint32_t n, int32_t ink)
+{
+    const SSD1306_Font *f = d->font;
+    int32_t available = l->left + l->width - l->x;
+    if (l->align == SSD1306_TEXT_CENTER)
+        l->x += (available - ink) / 2;
+    else if (l->align == SSD1306_TEXT_RIGHT)
+        l->x += available - ink;
+    if (ink > l->widest)
+        l->widest = ink;
+    l->lines++;
+    if (!l->draw)
+        return;
+    int32_t x = l->x;
+    int32_t advance = 0;
+    for (uint32_t i = 0; i < n; i++)
+        advance += f->character_width[glyphs[i]] + f->character_spacing;
+    int32_t right = x + advance - f->character_spacing - 1;
+    if (n > 0 && f->encoding == SSD1306_FONT_RAW && (l->y & 7) == 0 && x >= d->clip_x1 && right <= d->clip_x2 &&
+        l->y >= d->clip_y1 && l->y + f->character_height * 8 - 1 <= d->clip_y2)
+    {
+        ssd1306_draw_glyph_line(d, glyphs, n, x, l->y, right);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < n; i++)
+        {
+            ssd1306_draw_glyph(d, glyphs[i], x, l->y);
+            x += f->character_width[glyphs[i]] + f->character_spacing;
+        }
+    }
+    l->x = l->x + advance;
+}
+
+/**
+ * Moves the layout to the start of the next line
+ * @param d pointer to SSD1306_Display
+ * @return false if the next line does not fit in the box
+ */
+static bool ssd1306_layout_break(SSD1306_Display *d, SSD1306_Layout *l)
+{
+    int32_t line_height = d->font->character_height * 8;
+    if (l->y + 2 * line_height > l->bottom)
+        return false;
+    l->x = l->left;
+    l->y += line_height;
+    return true;
+}
+
+/**
+ * Lays out a text in a single pass: measures every glyph once, breaks lines at the last space
+ * before the box width, or inside a word longer than a line, and aligns and draws each line
+ * as it is completed. The layout is left at the end of the last glyph laid out
+ * @param d pointer to SSD1306_Display
+ * @param text UTF-8 text to lay out, '\n' starts a new line
+ */
+static void ssd1306_layout_text(SSD1306_Display *d, SSD1306_Layout *l, const char *text)
+{
+    const SSD1306_Font *f = d->font;
+    uint16_t glyphs[SSD1306_LAYOUT_GLYPHS];
+    /* Glyphs of the line and its width with and without the trailing spaces */
+    uint32_t n = 0;
+    int32_t pen = 0;
+    int32_t ink = 0;
+    /* Last word of the line: first glyph and width; the line may break before it if breakable,
+     * leaving brk_ink as the width of the line. An indented line may move entirely to the next one */
+    uint32_t start = 0;
+    int32_t word = 0;
+    bool breakable = l->x > l->left;
+    int32_t brk_ink = 0;
+    bool space = false;
+    bool wrapped = false;
+    bool words = false;
+    while (*text)
+    {
+        uint32_t c = ssd1306_utf8_next(&text);
+        if (c == '\n')
+        {
+            ssd1306_layout_line(d, l, glyphs, n, ink);
+            if (!ssd1306_layout_break(d, l))
+                return;
+            n = start = 0;
+            pen = ink = word = 0;
+            breakable = space = wrapped = words = false;
+            continue;
+        }
+        uint32_t character = ssd1306_glyph_index(f, c);
+        uint8_t width = f->character_width[character];
+        if (c == ' ')
+        {
+            /* Spaces where a line wraps are dropped */
+            if (n == 0 && wrapped)
+                continue;
+            space = true;
+        }
+        else if (space)
+        {
+            /* Breaking after spaces alone would leave the line empty */
+            start = n;
+            word = 0;
+            breakable = words || l->x > l->left;
+            brk_ink = ink;
+            space = false;
         }
+        int32_t next = pen + (n ? f->character_spacing : 0) + width;
+        bool full = l->draw && n == SSD1306_LAYOUT_GLYPHS;
+        if (full || (l->width > 0 && !space && next > l->left + l->width - l->x && (n > 0 || breakable)))
+        {
+            if (breakable && !full)
+            {
+                /* Break before the last word and carry it to the next line */
+                ssd1306_layout_line(d, l, glyphs, start, brk_ink);
+                n -= start;
+                if (l->draw)
+                    memmove(glyphs, glyphs + start, n * sizeof(glyphs[0]));
+                pen = ink = word;
+            }
+            else
+            {
+                ssd1306_layout_line(d, l, glyphs, n, ink);
+                n = 0;
+                pen = ink = word = 0;
+            }
+            if (!ssd1306_layout_break(d, l))
+                return;
+            start = 0;
+            breakable = false;
+            wrapped = true;
+            words = n > 0;
+            next = pen + (n ? f->character_spacing : 0) + width;
+            if (n > 0 && next > l->width)
+            {
+                /* The word is longer than a line */
+                ssd1306_layout_line(d, l, glyphs, n, ink);
+                if (!ssd1306_layout_break(d, l))
+                    return;
+                n = 0;
+                pen = ink = word = 0;
+                words = false;
+                next = width;
+            }
+        }
+        if (l->draw)
+            glyphs[n] = character;
+        if (!space)
+        {
+            words = true;
+            word += (n > start ? f->character_spacing : 0) + width;
+            ink = next;
+        }
+        pen = next;
+        n++;
+    }
+    ssd1306_layout_line(d, l, glyphs, n, ink);
+}
+
+/**
+ * Lays out a text from the cursor to the bottom of the display and leaves the cursor after it
+ * @param d pointer to SSD1306_Display
+ * @param x left column of the first line
+ * @param a alignement: SSD1306_TEXT_CENTER, SSD1306_TEXT_LEFT or SSD1306_TEXT_RIGHT
+ */
+static void ssd1306_print_from(SSD1306_Display *d, const char *text, int16_t x, uint8_t a)
+{
+    SSD1306_Layout l = {
+        .left = 0,
+        .width = SSD1306_WIDTH(d),
+        .bottom = SSD1306_HEIGHT(d),
+        .x = x,
+        .y = d->cursor_y,
+        .align = a,
+        .draw = true,
+    };
+    ssd1306_layout_text(d, &l, text);
+    d->cursor_x = l.x;
+    d->cursor_y = l.y;
+}
+
+void ssd1306_print(SSD1306_Display *d, const char *text)
+{
+    ssd1306_print_from(d, text, d->cursor_x, SSD1306_TEXT_LEFT);
+}
+
+void ssd1306_println(SSD1306_Display *d, const char *text)
+{
+    ssd1306_print_from(d, text, d->cursor_x, SSD1306_TEXT_LEFT);
+    if (d->cursor_y + 2 * d->font->character_height * 8 <= SSD1306_HEIGHT(d))
+    {
+        d->cursor_x = 0;
+        d->cursor_y += d->font->character_height * 8;
+    }
+}
+
+void ssd1306_print_aligned(SSD1306_Display *d, const char *text, uint8_t a)
+{
+    ssd1306_print_from(d, text, 0, a);
+    if (d->cursor_y + 2 * d->font->character_height * 8 <= SSD1306_HEIGHT(d))
+    {
+        d->cursor_x = 0;
+        d->cursor_y += d->font->character_height * 8;
     }
-    ssd1306_set_cursor(d, c, r);
-    ssd1306_println(d, text);
 }
 
-void ssd1306_activate_horizontal_scroll(uint8_t rl, uint8_t start_page, uint8_t end_page, uint8_t frame_rate)
+void ssd1306_print_box(SSD1306_Display *d, const char *text, int16_t x, int16_t y, int16_t width, int16_t height, uint8_t a)
+{
+    if (width <= 0 || height <= 0)
+        return;
+    uint8_t clip_x1 = d->clip_x1, clip_y1 = d->clip_y1, clip_x2 = d->clip_x2, clip_y2 = d->clip_y2;
+    int32_t x1 = x, y1 = y, x2 = (int32_t)x + width - 1, y2 = (int32_t)y + height - 1;
+    if (!ssd1306_intersect(&x1, &y1, &x2, &y2, clip_x1, clip_y1, clip_x2, clip_y2))
+        return;
+    d->clip_x1 = x1;
+    d->clip_y1 = y1;
+    d->clip_x2 = x2;
+    d->clip_y2 = y2;
+    SSD1306_Layout l = {
+        .left = x,
+        .width = width,
+        .bottom = (int32_t)y + height,
+        .x = x,
+        .y = y,
+        .align = a,
+        .draw = true,
+    };
+    ssd1306_layout_text(d, &l, text);
+    d->clip_x1 = clip_x1;
+    d->clip_y1 = clip_y1;
+    d->clip_x2 = clip_x2;
+    d->clip_y2 = clip_y2;
+}
+
+void ssd1306_measure_text(SSD1306_Display *d, const char *text, int16_t width, int16_t *text_width, int16_t *text_height)
+{
+    SSD1306_Layout l = {
+        .left = 0,
+        .width = width,
+        .bottom = INT32_MAX / 2,
+        .x = 0,
+        .y = 0,
+        .align = SSD1306_TEXT_LEFT,
+        .draw = false,
+    };
+    ssd1306_layout_text(d, &l, text);
+    *text_width = l.widest;
+    *text_height = l.lines * d->font->character_height * 8;
+}
+
+void ssd1306_activate_horizontal_scroll(SSD1306_Display *d, uint8_t rl, uint8_t start_page, uint8_t end_page, uint8_t frame_rate)
 {
     const uint8_t scroll_commands[9] = {
         SSD1306_CONTROL_BYTE_COMMAND,
@@ -310,9 +1926,9 @@ void ssd1306_activate_horizontal_scroll(uint8_t rl, uint8_t start_page, uint8_t
         SSD1306_DUMMY_BYTE_00,
         SSD1306_DUMMY_BYTE_FF,
         SSD1306_ACTIVATE_SCROLL};
-    ssd1306_write(scroll_commands, 9);
+    ssd1306_write_commands(d, scroll_commands, 9);
 }
-void ssd1306_activate_vertical_and_horizontal_scroll(uint8_t rl, uint8_t start_page, uint8_t end_page, uint8_t start_row, uint8_t end_row, uint8_t vertical_scrolling_offset, uint8_t frame_rate)
+void ssd1306_activate_vertical_and_horizontal_scroll(SSD1306_Display *d, uint8_t rl, uint8_t start_page, uint8_t end_page, uint8_t start_row, uint8_t end_row, uint8_t vertical_scrolling_offset, uint8_t frame_rate)
 {
     const uint8_t scroll_commands[11] = {
         SSD1306_CONTROL_BYTE_COMMAND,
@@ -327,15 +1943,15 @@ void ssd1306_activate_vertical_and_horizontal_scroll(uint8_t rl, uint8_t start_p
         vertical_scrolling_offset,
         SSD1306_ACTIVATE_SCROLL
     };
-    ssd1306_write(scroll_commands, 11);
+    ssd1306_write_commands(d, scroll_commands, 11);
 }
 
-void ssd1306_deactivate_scroll(void)
+void ssd1306_deactivate_scroll(SSD1306_Display *d)
 {
     const uint8_t deactivation_command[2] = 
     {
         SSD1306_CONTROL_BYTE_COMMAND,
         SSD1306_DEACTIVATE_SCROLL
     };
-    ssd1306_write(deactivation_command, 2);
+    ssd1306_write_commands(d, deactivation_command, 2);
 }
\ No newline at end of file
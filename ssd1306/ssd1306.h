@@ -1,24 +1,21 @@
 /**
  * @file ssd1306.h
- * @brief Library to drive a SSD1306 128x64 dot matrix OLED display using I2C
+ * @brief Library to drive a SSD1306 128x64 dot matrix OLED display
  * @author Iván Santiago
  * @date 2023-07-31 20:43
  */
 #ifndef SSD1306_H_
 #define SSD1306_H_
 
-// #include <stdint.h>
-#include "hardware/i2c.h"
+#include <stdint.h>
 #include "ssd1306_font.h"
+#include "ssd1306_transport.h"
+#include "ssd1306_diff.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
-/**
- * I2C instance
- */
-#define SSD1306_I2C i2c0
-/**
- * SSD1306 I2C address
- */
-#define SSD1306_ADDRESS 0x3C
 /**
  * Set constrast control command: Double byte command to select 1 out of 256 contrast steps
  * @note Reset 0x7F
@@ -355,6 +352,174 @@
  * Text aligned to right
 */
 #define SSD1306_TEXT_RIGHT 2
+/**
+ * Primitives set their pixels
+*/
+#define SSD1306_DRAW_SET 0
+/**
+ * Primitives clear their pixels
+*/
+#define SSD1306_DRAW_CLEAR 1
+/**
+ * Primitives toggle their pixels, drawing twice restores the frame
+*/
+#define SSD1306_DRAW_XOR 2
+/**
+ * Bitmap ORed on the frame
+*/
+#define SSD1306_BLIT_OR 0
+/**
+ * Bitmap pixels cleared from the frame
+*/
+#define SSD1306_BLIT_AND_NOT 1
+/**
+ * Bitmap pixels toggled on the frame
+*/
+#define SSD1306_BLIT_XOR 2
+/**
+ * Bitmap copied over the frame, set and cleared pixels
+*/
+#define SSD1306_BLIT_COPY 3
+/**
+ * Fixed geometry mode: defining SSD1306_FIXED_WIDTH and SSD1306_FIXED_HEIGHT turns the
+ * display width, height and pages into constants, so the frame index arithmetic is folded
+ * by the compiler and the library buffers are sized for that panel only
+ */
+#ifdef SSD1306_FIXED_WIDTH
+#define SSD1306_WIDTH(d) SSD1306_FIXED_WIDTH
+#define SSD1306_HEIGHT(d) SSD1306_FIXED_HEIGHT
+#define SSD1306_PAGES(d) (SSD1306_FIXED_HEIGHT >> 3)
+/**
+ * Maximum number of columns of a frame
+ */
+#define SSD1306_MAX_WIDTH SSD1306_FIXED_WIDTH
+/**
+ * Maximum number of pages of a frame
+ */
+#define SSD1306_MAX_PAGES (SSD1306_FIXED_HEIGHT >> 3)
+#else
+#define SSD1306_WIDTH(d) ((d)->width)
+#define SSD1306_HEIGHT(d) ((d)->heigth)
+#define SSD1306_PAGES(d) ((d)->pages)
+#define SSD1306_MAX_WIDTH 128
+#define SSD1306_MAX_PAGES 8
+#endif
+/**
+ * Value of dirty_start when a page has no dirty columns
+ */
+#define SSD1306_CLEAN_PAGE 0xFF
+/**
+ * Maximum frame length: control byte plus SSD1306_MAX_WIDTH columns by SSD1306_MAX_PAGES pages
+ */
+#define SSD1306_MAX_FRAME_LENGTH (1 + SSD1306_MAX_WIDTH * SSD1306_MAX_PAGES)
+
+/**
+ * Length of the frame of a width x height panel: control byte plus width * height / 8 GDDRAM bytes
+ */
+#define SSD1306_FRAME_LENGTH(width, height) (1 + (width) * ((height) >> 3))
+/**
+ * SSD1306_Display.owned_buffers flags: memory allocated by the library and freed by ssd1306_destroy_display
+ */
+#define SSD1306_OWNS_DISPLAY 0x01
+#define SSD1306_OWNS_FRAME 0x02
+#define SSD1306_OWNS_FRONT 0x04
+#define SSD1306_OWNS_SHADOW 0x08
+
+/**
+ * Caller-owned frame storage for ssd1306_init_static,
+ * every buffer must hold SSD1306_FRAME_LENGTH(width, height) bytes
+ */
+typedef struct ssd1306_buffers
+{
+    /** Frame the primitives draw on, required */
+    uint8_t *frame;
+    /** Front buffer of the double buffer mode, NULL to disable it */
+    uint8_t *front;
+    /** Shadow frame of the diff encoder, NULL to disable it */
+    uint8_t *shadow;
+} SSD1306_Buffers;
+
+/**
+ * 1-bpp bitmap in the page format of the SSD1306 and the font arrays: each byte is
+ * a column of 8 pixels, least significant bit on top
+ */
+typedef struct ssd1306_bitmap
+{
+    /** Byte of column c and page p at data[c + p * stride] */
+    const uint8_t *data;
+    /** Pixels drawn, same layout as data, NULL to draw every pixel */
+    const uint8_t *mask;
+    uint8_t width;
+    /** Height in dots, any value */
+    uint8_t height;
+    /** Bytes from one page of the bitmap to the next, width for packed bitmaps */
+    uint16_t stride;
+} SSD1306_Bitmap;
+
+/**
+ * Panel geometry
+ */
+typedef struct ssd1306_geometry
+{
+    uint8_t width;
+    /** Height in dots, multiple of 8 */
+    uint8_t height;
+    /** First GDDRAM column wired to the panel */
+    uint8_t column_offset;
+    /** Parameter of SSD1306_SET_COM_PINS_HARDWARE_CONFIGURATION */
+    uint8_t com_pins;
+} SSD1306_Geometry;
+
+/**
+ * Geometry of the 0.96" 128x64 panels
+ */
+extern const SSD1306_Geometry ssd1306_128x64;
+/**
+ * Geometry of the 0.91" 128x32 panels
+ */
+extern const SSD1306_Geometry ssd1306_128x32;
+/**
+ * Geometry of the 0.69" 96x16 panels
+ */
+extern const SSD1306_Geometry ssd1306_96x16;
+/**
+ * Geometry of the 0.42" 72x40 panels
+ */
+extern const SSD1306_Geometry ssd1306_72x40;
+/**
+ * Geometry of the 0.66" 64x48 panels
+ */
+extern const SSD1306_Geometry ssd1306_64x48;
+
+/**
+ * Performance counters of a SSD1306_Display, only updated when the library is
+ * compiled with SSD1306_ENABLE_STATS
+ */
+typedef struct ssd1306_stats
+{
+    /** Updates started */
+    uint32_t frames;
+    /** Pixels changed by ssd1306_put_pixel, the primitives drawn pixel by pixel and ssd1306_draw_bitmap */
+    uint32_t pixels;
+    /** Glyphs rendered by the text functions */
+    uint32_t glyphs;
+    /** Bytes handed to the transport, control bytes included */
+    uint32_t bytes;
+    /** Command and data frames handed to the transport */
+    uint32_t transactions;
+    /** Time spent between updates */
+    uint64_t render_us;
+    /** Time spent in updates, until the transfer finishes for asynchronous ones */
+    uint64_t transmit_us;
+    uint32_t last_render_us;
+    uint32_t last_transmit_us;
+} SSD1306_Stats;
+
+#ifdef SSD1306_ENABLE_STATS
+#define SSD1306_STATS_ADD(d, counter, n) ((d)->stats.counter += (n))
+#else
+#define SSD1306_STATS_ADD(d, counter, n) ((void)0)
+#endif
 
 typedef struct ssd1306_display
 {
@@ -363,35 +528,133 @@ typedef struct ssd1306_display
     uint8_t pages;
     uint8_t max_x;
     uint8_t max_y;
+    /** First GDDRAM column wired to the panel */
+    uint8_t column_offset;
     uint32_t frame_length;
+    /** Frame the primitives draw on, the back buffer in double buffer mode */
     uint8_t *frame;
+    /** Frame owned by the transport in double buffer mode, NULL otherwise */
+    uint8_t *front;
+    /** Copy of the GDDRAM content used by the diff encoder, NULL if disabled */
+    uint8_t *shadow;
+    bool shadow_valid;
+    /** SSD1306_OWNS_* flags */
+    uint8_t owned_buffers;
     
-    SSD1306_Font *font;
-    uint32_t cursor_position;
-    uint32_t line_limit;
+    /** SSD1306_DRAW_* mode of lines, shapes and text */
+    uint8_t draw_mode;
+    /** Bits of the drawn mask cleared, then... */
+    uint8_t draw_clear;
+    /** ...bits of the drawn mask toggled: b = (b & ~(m & draw_clear)) ^ (m & draw_toggle) */
+    uint8_t draw_toggle;
+    /** Clip rectangle, inclusive, inside the display: primitives only draw inside it */
+    uint8_t clip_x1;
+    uint8_t clip_y1;
+    uint8_t clip_x2;
+    uint8_t clip_y2;
+
+    const SSD1306_Font *font;
+    /** Top left corner of the next glyph, in pixels */
+    int16_t cursor_x;
+    int16_t cursor_y;
+
+    /** First modified column of each page, SSD1306_CLEAN_PAGE if the page is clean */
+    uint8_t dirty_start[SSD1306_MAX_PAGES];
+    /** Last modified column of each page */
+    uint8_t dirty_end[SSD1306_MAX_PAGES];
+
+    const SSD1306_Transport *transport;
+    void *transport_context;
+
+    /** True while an asynchronous update is in progress */
+    volatile bool busy;
+    SSD1306_Callback update_callback;
+    void *update_user_data;
+    /** Windows of the asynchronous update in progress, sent one transfer at a time */
+    SSD1306_Update_Plan update_plan;
+    /** Frame written by the asynchronous update, d->frame or d->front */
+    uint8_t *update_frame;
+    /** Next window of update_plan to send */
+    uint8_t update_window;
+    /** Next page of that window to send, SSD1306_CLEAN_PAGE before its window command frame */
+    uint8_t update_page;
+    /** Window command frame of the transfer in progress */
+    uint8_t update_commands[SSD1306_WINDOW_COMMAND_LENGTH];
+
+#ifdef SSD1306_ENABLE_STATS
+    SSD1306_Stats stats;
+    /** Timestamp of the last update start or end */
+    uint64_t stats_mark_us;
+#endif
 } SSD1306_Display;
 
 /**
- * Writes data/command on the SSD1306
+ * Writes commands on the SSD1306
+ * @param d pointer to SSD1306_Display
+ * @param commands bytes to be written
+ * @param length number of bytes to be written
+ * @note The first byte of commands must be the control byte 'SSD1306_CONTROL_BYTE_COMMAND'
+*/
+static inline void ssd1306_write_commands(SSD1306_Display *d, const uint8_t *commands, uint32_t length)
+{
+    SSD1306_STATS_ADD(d, bytes, length);
+    SSD1306_STATS_ADD(d, transactions, 1);
+    d->transport->write_commands(d->transport_context, commands, length);
+}
+
+/**
+ * Writes data on the SSD1306 GDDRAM
+ * @param d pointer to SSD1306_Display
  * @param data bytes to be written
  * @param length number of bytes to be written
- * @note The first byte of data must be a byte control 'SSD1306_CONTROL_BYTE_COMMAND' 
- * to write a frame of commands or 'SSD1306_CONTROL_BYTE_DATA' to write on the GDDRAM
+ * @note The first byte of data must be the control byte 'SSD1306_CONTROL_BYTE_DATA'
 */
-static inline void ssd1306_write(const uint8_t *data, uint32_t length)
+static inline void ssd1306_write_data(SSD1306_Display *d, const uint8_t *data, uint32_t length)
 {
-    i2c_write_blocking(SSD1306_I2C, SSD1306_ADDRESS, data, length, false);
+    SSD1306_STATS_ADD(d, bytes, length);
+    SSD1306_STATS_ADD(d, transactions, 1);
+    d->transport->write_data(d->transport_context, data, length);
 }
 
 /**
  * Set the display to a resolution of 128x64 dots in normal mode
  * and horizontal addressing mode
- * @return a pointer to SSD1306_Display
+ * @param transport set of functions used to reach the SSD1306
+ * @param context pointer passed to every transport function
+ * @return a pointer to SSD1306_Display, NULL if out of memory or, in fixed geometry mode,
+ * if no predefined SSD1306_Geometry matches SSD1306_FIXED_WIDTH x SSD1306_FIXED_HEIGHT
+ * @note In fixed geometry mode the predefined SSD1306_Geometry of that size is used
+ * @note ssd1306_init (ssd1306_pico.h) uses the I2C transport on SSD1306_I2C
+ */
+SSD1306_Display *ssd1306_init_transport(const SSD1306_Transport *transport, void *context);
+
+/**
+ * Set the display to the resolution of a panel in normal mode and horizontal addressing mode:
+ * multiplex ratio, COM pins configuration and column window follow the geometry
+ * @param g panel geometry, e.g. &ssd1306_128x32
+ * @param transport set of functions used to reach the SSD1306
+ * @param context pointer passed to every transport function
+ * @return a pointer to SSD1306_Display, NULL if g does not match the fixed geometry
  */
-SSD1306_Display *ssd1306_init(void);
+SSD1306_Display *ssd1306_init_geometry(const SSD1306_Geometry *g, const SSD1306_Transport *transport, void *context);
 
 /**
- * Deallocates the memory used by a SSD1306_Display
+ * Initializes a display on caller-owned storage, without allocating memory:
+ * same set up as ssd1306_init_geometry, with the double buffer mode and the diff
+ * encoder enabled when their buffers are given
+ * @param d storage of the SSD1306_Display
+ * @param b frame storage, each buffer of SSD1306_FRAME_LENGTH(g->width, g->height) bytes
+ * @param g panel geometry
+ * @param transport set of functions used to reach the SSD1306
+ * @param context pointer passed to every transport function
+ * @return d, NULL if the geometry is not supported or b has no frame
+ * @note ssd1306_destroy_display does not free caller-owned storage
+ */
+SSD1306_Display *ssd1306_init_static(SSD1306_Display *d, const SSD1306_Buffers *b, const SSD1306_Geometry *g,
+                                     const SSD1306_Transport *transport, void *context);
+
+/**
+ * Deallocates the memory allocated by the library for a SSD1306_Display
  * @param d pointer to SSD1306_Display
  */
 void ssd1306_destroy_display(SSD1306_Display *d);
@@ -403,30 +666,209 @@ void ssd1306_destroy_display(SSD1306_Display *d);
 void ssd1306_clean(SSD1306_Display *d);
 
 /**
- * Writes the frame content of SSD1306_Display on the SSD1306 GDDRAM
+ * Writes the modified regions of the SSD1306_Display frame on the SSD1306 GDDRAM
+ * and marks the whole frame as clean
  * @param d pointer to SSD1306_Display
+ * @note Only the dirty column span of each page is transmitted, encoded by
+ * ssd1306_encode_diff, which writes the whole frame in a single transfer when cheaper
  */
 void ssd1306_update_graphics(SSD1306_Display *d);
 
 /**
- * Sets a pixel in the (x, y) position
+ * Starts writing the modified pages of the SSD1306_Display frame on the SSD1306 GDDRAM
+ * and returns without waiting for the transfer, then marks the whole frame as clean
  * @param d pointer to SSD1306_Display
- * @param x position on the x-axis
- * @param y position on the y-axis
+ * @param callback function called when the transfer finishes, may be NULL
+ * @param user_data pointer passed to callback
+ * @return false if the transfer could not be started, the frame remains dirty
+ * @note The windows are the ones ssd1306_update_graphics would write, see ssd1306_plan_update;
+ * each transfer is queued from the completion callback of the previous one and callback is
+ * called after the last one. The frame must not be modified until the update finishes, see ssd1306_update_busy,
+ * unless the display is in double buffer mode (ssd1306_enable_double_buffer).
+ * If the transport has no asynchronous support the update is done before returning.
+ */
+bool ssd1306_update_graphics_async(SSD1306_Display *d, SSD1306_Callback callback, void *user_data);
+
+/**
+ * Allocates a second frame and switches the SSD1306_Display to double buffer mode:
+ * the updates swap the back buffer (d->frame) with the front buffer, copy the dirty
+ * regions of the presented frame into the new back buffer and transmit the front buffer,
+ * so the next frame can be drawn while the previous one is being transmitted
+ * @param d pointer to SSD1306_Display
+ * @return false if the frame could not be allocated
+ */
+bool ssd1306_enable_double_buffer(SSD1306_Display *d);
+
+/**
+ * Allocates a shadow copy of the GDDRAM and enables the diff encoder: the updates
+ * compare the dirty regions against the shadow and only write the bytes that changed,
+ * see ssd1306_encode_diff
+ * @param d pointer to SSD1306_Display
+ * @return false if the shadow frame could not be allocated
+ */
+bool ssd1306_enable_diff_encoding(SSD1306_Display *d);
+
+/**
+ * Computes the windows the next ssd1306_update_graphics would write, without writing them
+ * @param d pointer to SSD1306_Display
+ * @param plan pointer to SSD1306_Update_Plan to fill
+ * @return bytes that would be handed to the transport
+ */
+uint32_t ssd1306_plan_update(const SSD1306_Display *d, SSD1306_Update_Plan *plan);
+
+/**
+ * Copies the performance counters of a SSD1306_Display
+ * @param d pointer to SSD1306_Display
+ * @param stats pointer to SSD1306_Stats to fill, zeroed without SSD1306_ENABLE_STATS
+ */
+void ssd1306_get_stats(const SSD1306_Display *d, SSD1306_Stats *stats);
+
+/**
+ * Resets the performance counters of a SSD1306_Display
+ * @param d pointer to SSD1306_Display
+ */
+void ssd1306_reset_stats(SSD1306_Display *d);
+
+/**
+ * Checks whether an asynchronous update is in progress
+ * @param d pointer to SSD1306_Display
+ * @return true until the transfer started by ssd1306_update_graphics_async finishes
  */
-static inline void ssd1306_put_pixel(SSD1306_Display *d, uint8_t x, uint8_t y)
+static inline bool ssd1306_update_busy(const SSD1306_Display *d)
 {
-    if (x < d->width && y < d->heigth)
+    return d->busy;
+}
+
+/**
+ * Blocks until the asynchronous update in progress, if any, finishes
+ * @param d pointer to SSD1306_Display
+ */
+void ssd1306_wait_update(SSD1306_Display *d);
+
+/**
+ * Marks the whole frame as dirty, the next ssd1306_update_graphics writes the complete frame
+ * @param d pointer to SSD1306_Display
+ * @note Use it when the GDDRAM content is lost or unknown, e.g. after deactivating a scroll
+ */
+void ssd1306_invalidate(SSD1306_Display *d);
+
+/**
+ * Adds the columns [c1, c2] of a page to its dirty span
+ * @param d pointer to SSD1306_Display
+ * @param page page [0 - (d.pages - 1)]
+ * @param c1 first column
+ * @param c2 last column
+ */
+static inline void ssd1306_mark_dirty(SSD1306_Display *d, uint8_t page, uint8_t c1, uint8_t c2)
+{
+    if (c1 < d->dirty_start[page])
+        d->dirty_start[page] = c1;
+    if (c2 > d->dirty_end[page])
+        d->dirty_end[page] = c2;
+}
+
+/**
+ * Sets, clears or toggles the pixel in the (x, y) position, following the draw mode,
+ * without checking the clip rectangle
+ * @param d pointer to SSD1306_Display
+ * @param x position on the x-axis, inside the display
+ * @param y position on the y-axis, inside the display
+ */
+static inline void ssd1306_plot_pixel(SSD1306_Display *d, uint8_t x, uint8_t y)
+{
+    uint32_t index = 1 + x + (y >> 3) * SSD1306_WIDTH(d);
+    uint8_t mask = 1 << (y % 8);
+    uint8_t value = (d->frame[index] & ~(mask & d->draw_clear)) ^ (mask & d->draw_toggle);
+    if (value != d->frame[index])
     {
-        uint32_t index = 1 + x + (y >> 3) * d->width;
-        if (d->frame[index] < 0xFF)
-        {
-            uint32_t value = 1 << (y % 8);
-            d->frame[index] |= value;
-        }
+        d->frame[index] = value;
+        ssd1306_mark_dirty(d, y >> 3, x, x);
+        SSD1306_STATS_ADD(d, pixels, 1);
     }
 }
 
+/**
+ * Sets, clears or toggles the pixel in the (x, y) position, following the draw mode,
+ * if it is inside the clip rectangle
+ * @param d pointer to SSD1306_Display
+ * @param x position on the x-axis
+ * @param y position on the y-axis
+ */
+static inline void ssd1306_put_pixel(SSD1306_Display *d, int16_t x, int16_t y)
+{
+    if (x >= d->clip_x1 && x <= d->clip_x2 && y >= d->clip_y1 && y <= d->clip_y2)
+        ssd1306_plot_pixel(d, x, y);
+}
+
+/**
+ * Restricts drawing to a rectangle of the display, the primitives clip against it
+ * @param d pointer to SSD1306_Display
+ * @param x left column
+ * @param y top row
+ * @param width width in pixels
+ * @param height height in pixels
+ */
+void ssd1306_set_clip(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height);
+
+/**
+ * Sets the clip rectangle to the whole display
+ * @param d pointer to SSD1306_Display
+ */
+void ssd1306_reset_clip(SSD1306_Display *d);
+
+/**
+ * Selects how lines, shapes and text change the pixels they cover
+ * @param d pointer to SSD1306_Display
+ * @param mode SSD1306_DRAW_SET, SSD1306_DRAW_CLEAR or SSD1306_DRAW_XOR
+ * @note the rectangle operations and ssd1306_draw_bitmap keep their own modes
+ */
+void ssd1306_set_draw_mode(SSD1306_Display *d, uint8_t mode);
+
+/**
+ * Clears the pixels of a rectangle of the SSD1306_Display frame
+ * @param d pointer to SSD1306_Display
+ * @param x left column
+ * @param y top row
+ * @param width width in pixels
+ * @param height height in pixels
+ * @note the bulk operations work on 32-bit words of each page and clip to the clip rectangle
+ */
+void ssd1306_clear_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height);
+
+/**
+ * Sets the pixels of a rectangle of the SSD1306_Display frame
+ * @param d pointer to SSD1306_Display
+ * @param x left column
+ * @param y top row
+ * @param width width in pixels
+ * @param height height in pixels
+ */
+void ssd1306_fill_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height);
+
+/**
+ * Inverts the pixels of a rectangle of the SSD1306_Display frame
+ * @param d pointer to SSD1306_Display
+ * @param x left column
+ * @param y top row
+ * @param width width in pixels
+ * @param height height in pixels
+ */
+void ssd1306_invert_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height);
+
+/**
+ * Copies a rectangle of the SSD1306_Display frame to (dx, dy), overlapping allowed
+ * @param d pointer to SSD1306_Display
+ * @param x source left column
+ * @param y source top row
+ * @param width width in pixels
+ * @param height height in pixels
+ * @param dx destination left column
+ * @param dy destination top row
+ * @return false if y and dy are not at the same row of their pages
+ * @note the source is clipped to the display, the destination to the clip rectangle
+ */
+bool ssd1306_copy_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height, int16_t dx, int16_t dy);
+
 /**
  * Draws a line from (x1, y1) to (x2, y2) on the SSD1306_Display frame
  * @param d pointer to SSD1306_Display
@@ -434,8 +876,9 @@ static inline void ssd1306_put_pixel(SSD1306_Display *d, uint8_t x, uint8_t y)
  * @param y1 first point y-axis position
  * @param x2 second point x-axis position
  * @param y2 second point y-axis position
+ * @note the endpoints may lie outside the display, the line is clipped to the clip rectangle
  */
-void ssd1306_draw_line(SSD1306_Display *d, int8_t x1, int8_t y1, int8_t x2, int8_t y2);
+void ssd1306_draw_line(SSD1306_Display *d, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
 
 /**
  * Draws an ellipse with center (cx, cy) on the SSD1306_Display frame
@@ -445,7 +888,7 @@ void ssd1306_draw_line(SSD1306_Display *d, int8_t x1, int8_t y1, int8_t x2, int8
  * @param a horizontal length
  * @param b vertical length
 */
-void ssd1306_draw_ellipse(SSD1306_Display *d, int8_t cx, int8_t cy, int8_t a, int8_t b);
+void ssd1306_draw_ellipse(SSD1306_Display *d, int16_t cx, int16_t cy, int16_t a, int16_t b);
 
 /**
  * Draws a circle with center (cx, xy) and radio r on the SSD1306_Display frame
@@ -454,7 +897,72 @@ void ssd1306_draw_ellipse(SSD1306_Display *d, int8_t cx, int8_t cy, int8_t a, in
  * @param cy center point y-axis position
  * @param r radius
 */
-void ssd1306_draw_circle(SSD1306_Display *d, int8_t cx, int8_t cy, int8_t r);
+void ssd1306_draw_circle(SSD1306_Display *d, int16_t cx, int16_t cy, int16_t r);
+
+/**
+ * Draws a filled circle with center (cx, cy) on the SSD1306_Display frame
+ * @param d pointer to SSD1306_Display
+ * @param cx center point x-axis position
+ * @param cy center point y-axis position
+ * @param r radius
+ */
+void ssd1306_fill_circle(SSD1306_Display *d, int16_t cx, int16_t cy, int16_t r);
+
+/**
+ * Draws a filled ellipse with center (cx, cy) on the SSD1306_Display frame
+ * @param d pointer to SSD1306_Display
+ * @param cx center point x-axis position
+ * @param cy center point y-axis position
+ * @param a horizontal length
+ * @param b vertical length
+ */
+void ssd1306_fill_ellipse(SSD1306_Display *d, int16_t cx, int16_t cy, int16_t a, int16_t b);
+
+/**
+ * Draws the outline of a triangle on the SSD1306_Display frame
+ * @param d pointer to SSD1306_Display
+ * @param x1 first vertex x-axis position
+ * @param y1 first vertex y-axis position
+ * @param x2 second vertex x-axis position
+ * @param y2 second vertex y-axis position
+ * @param x3 third vertex x-axis position
+ * @param y3 third vertex y-axis position
+ */
+void ssd1306_draw_triangle(SSD1306_Display *d, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3);
+
+/**
+ * Draws a filled triangle on the SSD1306_Display frame, covering its ssd1306_draw_triangle outline
+ * @param d pointer to SSD1306_Display
+ * @param x1 first vertex x-axis position
+ * @param y1 first vertex y-axis position
+ * @param x2 second vertex x-axis position
+ * @param y2 second vertex y-axis position
+ * @param x3 third vertex x-axis position
+ * @param y3 third vertex y-axis position
+ */
+void ssd1306_fill_triangle(SSD1306_Display *d, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3);
+
+/**
+ * Draws a filled rectangle with rounded corners on the SSD1306_Display frame
+ * @param d pointer to SSD1306_Display
+ * @param x left column
+ * @param y top row
+ * @param width width in pixels
+ * @param height height in pixels
+ * @param r corner radius, limited to fit the rectangle
+ */
+void ssd1306_fill_rounded_rect(SSD1306_Display *d, int16_t x, int16_t y, int16_t width, int16_t height, int16_t r);
+
+/**
+ * Draws a bitmap with its top left corner at (x, y) on the SSD1306_Display frame,
+ * each bitmap byte is split across two frame pages when y is not a multiple of 8
+ * @param d pointer to SSD1306_Display
+ * @param b bitmap
+ * @param x left column
+ * @param y top row
+ * @param mode SSD1306_BLIT_OR, SSD1306_BLIT_AND_NOT, SSD1306_BLIT_XOR or SSD1306_BLIT_COPY
+ */
+void ssd1306_draw_bitmap(SSD1306_Display *d, const SSD1306_Bitmap *b, int16_t x, int16_t y, uint8_t mode);
 
 /**
  * Sets cursor position
@@ -464,47 +972,86 @@ void ssd1306_draw_circle(SSD1306_Display *d, int8_t cx, int8_t cy, int8_t r);
 */
 void ssd1306_set_cursor(SSD1306_Display *d, uint8_t c, uint8_t r);
 
+/**
+ * Sets cursor position in pixels, text placed at any row is shifted across pages
+ * and clipped to the clip rectangle
+ * @param d pointer to SSD1306_Display
+ * @param x left column of the next glyph
+ * @param y top row of the next glyph
+*/
+void ssd1306_set_cursor_xy(SSD1306_Display *d, int16_t x, int16_t y);
+
 /**
  * Sets the SSD1306_Font on the SSD1306_Display and sets the cursor position to (0, 0)
  * @param d pointer to SSD1306_Display
  * @param font pointer to font to set
 */
-void ssd1306_set_font(SSD1306_Display *d, SSD1306_Font *f);
+void ssd1306_set_font(SSD1306_Display *d, const SSD1306_Font *f);
 
 /**
- * Draws a text on the SSD1306_Display frame
+ * Draws a text on the SSD1306_Display frame at the cursor. Lines wrap at word boundaries,
+ * or inside words longer than the display width, and '\n' starts a new line. The text stops
+ * when the next line does not fit in the display. Characters missing from the font and
+ * malformed UTF-8 are drawn as the overflow character
  * @param d pointer to SSD1306_Display
- * @param text text to print
+ * @param text UTF-8 text to print
 */
 void ssd1306_print(SSD1306_Display *d, const char *text);
 
 /**
  * Draws a text on the SSD1306_Display frame and moves the cursor to the next line
  * @param d ponter to SSD1306_Display
- * @param text text to print
+ * @param text UTF-8 text to print
 */
 void ssd1306_println(SSD1306_Display *d, const char *text);
 
 /**
- * Draws a text aligned on the SSD1306_Display frame and moves the cursor to the next line
+ * Draws a text aligned on the SSD1306_Display frame and moves the cursor to the next line,
+ * every wrapped line is aligned on its own
  * @param d ponter to SSD1306_Display
- * @param text text to print
+ * @param text UTF-8 text to print
  * @param a alignement: SSD1306_TEXT_CENTER, SSD1306_TEXT_LEFT or SSD1306_TEXT_RIGHT
 */
 void ssd1306_print_aligned(SSD1306_Display *d, const char *text, uint8_t a);
 
+/**
+ * Draws a text in a box, wrapped at word boundaries to the box width, every line aligned
+ * on its own and clipped to the box. Lines below the first one are drawn while they fit
+ * in the box height. The cursor is not moved
+ * @param d pointer to SSD1306_Display
+ * @param text UTF-8 text to print
+ * @param x left column of the box
+ * @param y top row of the box
+ * @param width box width
+ * @param height box height
+ * @param a alignement: SSD1306_TEXT_CENTER, SSD1306_TEXT_LEFT or SSD1306_TEXT_RIGHT
+*/
+void ssd1306_print_box(SSD1306_Display *d, const char *text, int16_t x, int16_t y, int16_t width, int16_t height, uint8_t a);
+
+/**
+ * Measures a text in the font of the SSD1306_Display as ssd1306_print_box would lay it out
+ * @param d pointer to SSD1306_Display
+ * @param text UTF-8 text to measure
+ * @param width box width the lines wrap to, 0 to break lines only at '\n'
+ * @param text_width returns the width of the widest line, without trailing spaces
+ * @param text_height returns the height of all the lines
+*/
+void ssd1306_measure_text(SSD1306_Display *d, const char *text, int16_t width, int16_t *text_width, int16_t *text_height);
+
 /**
  * Configures and activates continuous horizontal scroll
+ * @param d pointer to SSD1306_Display
  * @param rl 0: left scroll; 1: right scroll
  * @param start_page range [0, 7]
  * @param end_page range [0, 7]
  * @param frame_rate 2, 3, 4, 5, 25, 64, 128 or 256 frames, use SSD1306_SCROLL_N_FRAMES macros
  * @note end_page most be larger or equal to start_page
 */
-void ssd1306_activate_horizontal_scroll(uint8_t rl, uint8_t start_page, uint8_t end_page, uint8_t frame_rate);
+void ssd1306_activate_horizontal_scroll(SSD1306_Display *d, uint8_t rl, uint8_t start_page, uint8_t end_page, uint8_t frame_rate);
 
 /**
  * Configures and activates continuous vertical and horizontal scroll
+ * @param d pointer to SSD1306_Display
  * @param rl 0: left and vertical scroll; 1 right and vertical scroll
  * @param start_page range [0, 7]
  * @param end_page range [0, 7]
@@ -514,11 +1061,16 @@ void ssd1306_activate_horizontal_scroll(uint8_t rl, uint8_t start_page, uint8_t
  * @param vertical_scrolling_offset range [0, 63]
  * @note end_row must be larger than vertical_scrolling_offset
 */
-void ssd1306_activate_vertical_and_horizontal_scroll(uint8_t rl, uint8_t start_page, uint8_t end_page, uint8_t start_row, uint8_t end_row, uint8_t vertical_scrolling_offset, uint8_t frame_rate);
+void ssd1306_activate_vertical_and_horizontal_scroll(SSD1306_Display *d, uint8_t rl, uint8_t start_page, uint8_t end_page, uint8_t start_row, uint8_t end_row, uint8_t vertical_scrolling_offset, uint8_t frame_rate);
 
 /**
  * Deactivates continuos scroll
- * @note After this command the ram data needs to be rewritten
+ * @param d pointer to SSD1306_Display
+ * @note After this command the ram data needs to be rewritten, see ssd1306_invalidate
 */
-void ssd1306_deactivate_scroll(void);
+void ssd1306_deactivate_scroll(SSD1306_Display *d);
+
+#ifdef __cplusplus
+}
+#endif
 #endif
\ No newline at end of file
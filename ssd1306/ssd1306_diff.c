@@ -0,0 +1,125 @@
+#include "ssd1306_diff.h"
+#include <stddef.h>
+
+/**
+ * Bytes handed to the transport to write a window: a full width window is contiguous
+ * in the frame and takes one data frame, narrower windows take one data frame per page
+ * @param w pointer to SSD1306_Window
+ * @param width columns per page
+ * @param frames number of data frames of the window
+ * @return bytes of the window
+ */
+static uint32_t ssd1306_window_bytes(const SSD1306_Window *w, uint8_t width, uint32_t *frames)
+{
+    uint32_t columns = w->column_end - w->column_start + 1;
+    uint32_t pages = w->page_end - w->page_start + 1;
+    *frames = columns == width ? 1 : pages;
+    return SSD1306_WINDOW_COMMAND_LENGTH + *frames + columns * pages;
+}
+
+/**
+ * Bus cost of writing a window
+ * @param w pointer to SSD1306_Window
+ * @param width columns per page
+ * @return cost in bytes
+ */
+static uint32_t ssd1306_window_cost(const SSD1306_Window *w, uint8_t width)
+{
+    uint32_t frames;
+    uint32_t bytes = ssd1306_window_bytes(w, width, &frames);
+    return bytes + (frames + 1) * SSD1306_TRANSACTION_OVERHEAD;
+}
+
+/**
+ * Finds the changed runs of a page and merges the ones separated by cheap gaps
+ * @return number of windows added to plan
+ */
+static uint8_t ssd1306_encode_page(const uint8_t *previous, const uint8_t *next, uint8_t page,
+                                   uint8_t c1, uint8_t c2, SSD1306_Window *windows)
+{
+    uint8_t count = 0;
+    if (previous == NULL)
+    {
+        windows[0] = (SSD1306_Window){page, page, c1, c2};
+        return 1;
+    }
+    int16_t run_start = -1;
+    int16_t run_end = -1;
+    for (int16_t c = c1; c <= c2; c++)
+    {
+        if (previous[c] == next[c])
+            continue;
+        if (run_start < 0)
+        {
+            run_start = c;
+        }
+        else if (c - run_end - 1 > SSD1306_WINDOW_COST && count < SSD1306_MAX_PAGE_WINDOWS - 1)
+        {
+            windows[count++] = (SSD1306_Window){page, page, (uint8_t)run_start, (uint8_t)run_end};
+            run_start = c;
+        }
+        run_end = c;
+    }
+    if (run_start >= 0)
+        windows[count++] = (SSD1306_Window){page, page, (uint8_t)run_start, (uint8_t)run_end};
+    return count;
+}
+
+uint32_t ssd1306_encode_diff(const uint8_t *previous, const uint8_t *next, uint8_t width, uint8_t pages,
+                             const uint8_t *dirty_start, const uint8_t *dirty_end, SSD1306_Update_Plan *plan)
+{
+    plan->count = 0;
+    plan->cost = 0;
+    uint8_t last_count = 0;
+    for (uint8_t page = 0; page < pages; page++)
+    {
+        if (dirty_start[page] > dirty_end[page])
+        {
+            last_count = 0;
+            continue;
+        }
+        uint32_t offset = 1 + page * width;
+        SSD1306_Window *windows = plan->windows + plan->count;
+        uint8_t count = ssd1306_encode_page(previous != NULL ? previous + offset : NULL, next + offset, page,
+                                            dirty_start[page], dirty_end[page], windows);
+        if (count == 1 && last_count == 1)
+        {
+            SSD1306_Window *above = windows - 1;
+            if (above->page_end == page - 1)
+            {
+                SSD1306_Window merged = *above;
+                merged.page_end = page;
+                if (windows->column_start < merged.column_start)
+                    merged.column_start = windows->column_start;
+                if (windows->column_end > merged.column_end)
+                    merged.column_end = windows->column_end;
+                if (ssd1306_window_cost(&merged, width) <= ssd1306_window_cost(above, width) + ssd1306_window_cost(windows, width))
+                {
+                    *above = merged;
+                    continue;
+                }
+            }
+        }
+        plan->count += count;
+        last_count = count;
+    }
+
+    for (uint8_t i = 0; i < plan->count; i++)
+        plan->cost += ssd1306_window_cost(&plan->windows[i], width);
+    const SSD1306_Window full = {0, pages - 1, 0, width - 1};
+    uint32_t full_cost = ssd1306_window_cost(&full, width);
+    if (plan->cost > full_cost)
+    {
+        plan->count = 1;
+        plan->windows[0] = full;
+        plan->cost = full_cost;
+    }
+
+    plan->bytes = 0;
+    for (uint8_t i = 0; i < plan->count; i++)
+    {
+        uint32_t frames;
+        plan->bytes += ssd1306_window_bytes(&plan->windows[i], width, &frames);
+    }
+    return plan->bytes;
+}
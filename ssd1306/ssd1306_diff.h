@@ -0,0 +1,84 @@
+/**
+ * @file ssd1306_diff.h
+ * @brief Frame diff encoder: finds the cheapest set of GDDRAM windows to update
+ * @author Iván Santiago
+ * @date 2023-08-08 21:05
+ */
+#ifndef SSD1306_DIFF_H_
+#define SSD1306_DIFF_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bytes of a window command frame: control byte, column address and page address commands
+ */
+#define SSD1306_WINDOW_COMMAND_LENGTH 7
+/**
+ * Bus bytes paid by every I2C transaction besides its payload: address byte plus start and stop
+ */
+#define SSD1306_TRANSACTION_OVERHEAD 2
+/**
+ * Cost of re-addressing the GDDRAM: window command frame plus the overhead of two transactions
+ * and the control byte of the data frame. Runs of a page separated by a larger gap are split.
+ */
+#define SSD1306_WINDOW_COST (SSD1306_WINDOW_COMMAND_LENGTH + 2 * SSD1306_TRANSACTION_OVERHEAD + 1)
+/**
+ * Maximum number of windows per page of a SSD1306_Update_Plan
+ */
+#define SSD1306_MAX_PAGE_WINDOWS 8
+/**
+ * Maximum number of windows of a SSD1306_Update_Plan
+ */
+#define SSD1306_MAX_WINDOWS (SSD1306_MAX_PAGE_WINDOWS * 8)
+
+/**
+ * GDDRAM window: a column range repeated over a page range, written in horizontal addressing mode.
+ * Full width windows are written in one data frame, narrower ones in one data frame per page.
+ */
+typedef struct ssd1306_window
+{
+    uint8_t page_start;
+    uint8_t page_end;
+    uint8_t column_start;
+    uint8_t column_end;
+} SSD1306_Window;
+
+/**
+ * Sequence of windows that brings the GDDRAM up to date
+ */
+typedef struct ssd1306_update_plan
+{
+    uint8_t count;
+    SSD1306_Window windows[SSD1306_MAX_WINDOWS];
+    /** Bytes handed to the transport: window commands plus control and GDDRAM bytes */
+    uint32_t bytes;
+    /** Bus cost of the plan in bytes, including the transaction overheads */
+    uint32_t cost;
+} SSD1306_Update_Plan;
+
+/**
+ * Encodes the difference between two frames as a sequence of GDDRAM windows.
+ * Changed runs of each page are merged while the unchanged gap between them is cheaper
+ * than re-addressing, single-window pages are merged vertically when that is cheaper,
+ * and the whole frame is sent in one window when that is the cheapest option.
+ * @param previous frame currently in the GDDRAM, NULL to consider every dirty byte changed
+ * @param next frame to write
+ * @param width columns per page
+ * @param pages number of pages
+ * @param dirty_start first column to consider of each page, 0xFF if the page is unchanged
+ * @param dirty_end last column to consider of each page
+ * @param plan pointer to SSD1306_Update_Plan to fill
+ * @return the bytes handed to the transport by the plan
+ * @note Frames include the control byte at index 0
+ */
+uint32_t ssd1306_encode_diff(const uint8_t *previous, const uint8_t *next, uint8_t width, uint8_t pages,
+                             const uint8_t *dirty_start, const uint8_t *dirty_end, SSD1306_Update_Plan *plan);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
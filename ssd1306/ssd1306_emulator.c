@@ -0,0 +1,320 @@
+#include "ssd1306_emulator.h"
+#include <string.h>
+
+/**
+ * Number of parameter bytes of a command
+ * @param command first byte of the command
+ * @return parameter bytes that follow the command
+ */
+static uint8_t ssd1306_emulator_parameters(uint8_t command)
+{
+    switch (command)
+    {
+    case SSD1306_SET_CONTRAST_CONTROL:
+    case SSD1306_CHARGE_PUMP_SETTING:
+    case SSD1306_SET_MULTIPLEX_RATIO:
+    case SSD1306_SET_DISPLAY_OFFSET:
+    case SSD1306_SET_DISPLAY_CLOCK_DIVIDE_RATIO:
+    case SSD1306_SET_PRECHARGE_PERIOD:
+    case SSD1306_SET_COM_PINS_HARDWARE_CONFIGURATION:
+    case SSD1306_SET_VCOMH_DESELECT_LEVEL:
+    case SSD1306_SET_MEMORY_ADDRESSING_MODE:
+        return 1;
+    case SSD1306_SET_COLUMN_ADDRESS:
+    case SSD1306_SET_PAGE_ADDRESS:
+    case SSD1306_SET_VERTICAL_SCROLL_AREA:
+        return 2;
+    case SSD1306_CONTINUOUS_HORIZONTAL_SCROLL_RIGHT:
+    case SSD1306_CONTINUOUS_HORIZONTAL_SCROLL_LEFT:
+        return 6;
+    case SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL:
+    case SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL:
+        return 5;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Executes the command stored in e->command
+ * @param e pointer to SSD1306_Emulator
+ */
+static void ssd1306_emulator_execute(SSD1306_Emulator *e)
+{
+    const uint8_t *c = e->command;
+    if (c[0] <= 0x0F)
+    {
+        e->column = (e->column & 0x70) | (c[0] & 0x0F);
+        return;
+    }
+    if (c[0] <= 0x1F)
+    {
+        e->column = (e->column & 0x0F) | ((c[0] & 0x07) << 4);
+        return;
+    }
+    if (c[0] >= 0x40 && c[0] <= 0x7F)
+    {
+        e->start_line = c[0] & 0x3F;
+        return;
+    }
+    if (c[0] >= 0xB0 && c[0] <= 0xB7)
+    {
+        e->page = c[0] & 0x07;
+        return;
+    }
+    switch (c[0])
+    {
+    case SSD1306_SET_MEMORY_ADDRESSING_MODE:
+        e->addressing_mode = c[1] & 0x03;
+        break;
+    case SSD1306_SET_COLUMN_ADDRESS:
+        e->column_start = c[1] & 0x7F;
+        e->column_end = c[2] & 0x7F;
+        e->column = e->column_start;
+        break;
+    case SSD1306_SET_PAGE_ADDRESS:
+        e->page_start = c[1] & 0x07;
+        e->page_end = c[2] & 0x07;
+        e->page = e->page_start;
+        break;
+    case SSD1306_SET_CONTRAST_CONTROL:
+        e->contrast = c[1];
+        break;
+    case SSD1306_CHARGE_PUMP_SETTING:
+        e->charge_pump = c[1];
+        break;
+    case SSD1306_SET_MULTIPLEX_RATIO:
+        e->multiplex_ratio = c[1] & 0x3F;
+        break;
+    case SSD1306_SET_DISPLAY_OFFSET:
+        e->display_offset = c[1] & 0x3F;
+        break;
+    case SSD1306_SET_DISPLAY_CLOCK_DIVIDE_RATIO:
+        e->clock_divide = c[1];
+        break;
+    case SSD1306_SET_PRECHARGE_PERIOD:
+        e->precharge = c[1];
+        break;
+    case SSD1306_SET_COM_PINS_HARDWARE_CONFIGURATION:
+        e->com_pins = c[1];
+        break;
+    case SSD1306_SET_VCOMH_DESELECT_LEVEL:
+        e->vcomh = c[1];
+        break;
+    case SSD1306_SET_SEGMENT_REMAP_0:
+    case SSD1306_SET_SEGMENT_REMAP_127:
+        e->segment_remap = c[0] == SSD1306_SET_SEGMENT_REMAP_127;
+        break;
+    case SSD1306_SET_COM_SCAN_DIRECTION_NORMAL_MODE:
+    case SSD1306_SET_COM_SCAN_DIRECTION_REMAPPED_MODE:
+        e->com_remap = c[0] == SSD1306_SET_COM_SCAN_DIRECTION_REMAPPED_MODE;
+        break;
+    case SSD1306_RESUME_TO_RAM_CONTENT:
+    case SSD1306_ENTIRE_DISPLAY_ON:
+        e->entire_display_on = c[0] == SSD1306_ENTIRE_DISPLAY_ON;
+        break;
+    case SSD1306_SET_NORMAL_DISPLAY:
+    case SSD1306_SET_INVERSE_DISPLAY:
+        e->inverse = c[0] == SSD1306_SET_INVERSE_DISPLAY;
+        break;
+    case SSD1306_SET_DISPLAY_OFF:
+    case SSD1306_SET_DISPLAY_ON:
+        e->display_on = c[0] == SSD1306_SET_DISPLAY_ON;
+        break;
+    case SSD1306_CONTINUOUS_HORIZONTAL_SCROLL_RIGHT:
+    case SSD1306_CONTINUOUS_HORIZONTAL_SCROLL_LEFT:
+    case SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL:
+    case SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL:
+        e->scroll_command = c[0];
+        e->scroll_start_page = c[2] & 0x07;
+        e->scroll_interval = c[3] & 0x07;
+        e->scroll_end_page = c[4] & 0x07;
+        e->scroll_vertical_offset = c[0] >= SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL ? c[5] & 0x3F : 0;
+        break;
+    case SSD1306_SET_VERTICAL_SCROLL_AREA:
+        e->scroll_area_top = c[1] & 0x3F;
+        e->scroll_area_rows = c[2] & 0x7F;
+        break;
+    case SSD1306_ACTIVATE_SCROLL:
+        e->scrolling = true;
+        break;
+    case SSD1306_DEACTIVATE_SCROLL:
+        e->scrolling = false;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Decodes a command byte, executing the command once all its parameters arrived
+ * @param e pointer to SSD1306_Emulator
+ * @param b command or parameter byte
+ */
+static void ssd1306_emulator_command(SSD1306_Emulator *e, uint8_t b)
+{
+    e->command_bytes++;
+    if (e->command_length == 0)
+        e->command_expected = 1 + ssd1306_emulator_parameters(b);
+    e->command[e->command_length++] = b;
+    if (e->command_length == e->command_expected)
+    {
+        ssd1306_emulator_execute(e);
+        e->command_length = 0;
+    }
+}
+
+/**
+ * Writes a GDDRAM byte and advances the pointer according to the addressing mode
+ * @param e pointer to SSD1306_Emulator
+ * @param b data byte
+ */
+static void ssd1306_emulator_data(SSD1306_Emulator *e, uint8_t b)
+{
+    e->data_bytes++;
+    e->gddram[e->page][e->column] = b;
+    switch (e->addressing_mode)
+    {
+    case SSD1306_HORIZONTAL_ADDRESSING_MODE:
+        if (e->column >= e->column_end)
+        {
+            e->column = e->column_start;
+            e->page = e->page >= e->page_end ? e->page_start : e->page + 1;
+        }
+        else
+        {
+            e->column++;
+        }
+        break;
+    case SSD1306_VERTICAL_ADDRESSING_M0DE:
+        if (e->page >= e->page_end)
+        {
+            e->page = e->page_start;
+            e->column = e->column >= e->column_end ? e->column_start : e->column + 1;
+        }
+        else
+        {
+            e->page++;
+        }
+        break;
+    default:
+        e->column = (e->column + 1) & 0x7F;
+        break;
+    }
+}
+
+static void ssd1306_emulator_transport_write(void *context, const uint8_t *data, uint32_t length)
+{
+    ssd1306_emulator_write(context, data, length);
+}
+
+static bool ssd1306_emulator_transport_submit(void *context, const uint8_t *data, uint32_t length, SSD1306_Callback callback, void *user_data)
+{
+    ssd1306_emulator_write(context, data, length);
+    if (callback != NULL)
+        callback(user_data);
+    return true;
+}
+
+static void ssd1306_emulator_transport_flush(void *context)
+{
+    (void)context;
+}
+
+const SSD1306_Transport ssd1306_emulator_transport = {
+    .write_commands = ssd1306_emulator_transport_write,
+    .write_data = ssd1306_emulator_transport_write,
+    .submit_async = ssd1306_emulator_transport_submit,
+    .flush = ssd1306_emulator_transport_flush};
+
+void ssd1306_emulator_init(SSD1306_Emulator *e, uint32_t clock_hz)
+{
+    memset(e, 0, sizeof(SSD1306_Emulator));
+    e->addressing_mode = SSD1306_PAGE_ADDRESING_MODE;
+    e->column_end = 127;
+    e->page_end = 7;
+    e->multiplex_ratio = 63;
+    e->com_pins = 0x12;
+    e->contrast = 0x7F;
+    e->clock_divide = 0x80;
+    e->precharge = 0x22;
+    e->vcomh = 0x20;
+    e->charge_pump = 0x10;
+    e->scroll_area_rows = 64;
+    e->clock_hz = clock_hz;
+}
+
+void ssd1306_emulator_write(SSD1306_Emulator *e, const uint8_t *data, uint32_t length)
+{
+    e->transactions++;
+    e->bus_clocks += 2 + (uint64_t)(length + 1) * 9;
+    uint32_t i = 0;
+    while (i < length)
+    {
+        uint8_t control = data[i++];
+        if (control & 0x3F)
+            e->errors++;
+        bool is_data = control & SSD1306_CONTROL_BYTE_DATA;
+        uint32_t end = (control & 0x80) ? i + 1 : length;
+        if (end > length)
+            end = length;
+        for (; i < end; i++)
+        {
+            if (is_data)
+                ssd1306_emulator_data(e, data[i]);
+            else
+                ssd1306_emulator_command(e, data[i]);
+        }
+    }
+}
+
+void ssd1306_emulator_reset_counters(SSD1306_Emulator *e)
+{
+    e->bus_clocks = 0;
+    e->transactions = 0;
+    e->command_bytes = 0;
+    e->data_bytes = 0;
+    e->errors = 0;
+}
+
+uint64_t ssd1306_emulator_bus_us(const SSD1306_Emulator *e)
+{
+    return e->bus_clocks * 1000000u / e->clock_hz;
+}
+
+bool ssd1306_emulator_pixel(const SSD1306_Emulator *e, uint8_t x, uint8_t y)
+{
+    if (!e->display_on)
+        return false;
+    if (e->entire_display_on)
+        return true;
+    uint8_t row = e->com_remap ? e->multiplex_ratio - y : y;
+    row = (row + e->display_offset + e->start_line) & 0x3F;
+    uint8_t column = e->segment_remap ? 127 - x : x;
+    bool lit = (e->gddram[row >> 3][column & 0x7F] >> (row & 7)) & 1;
+    return lit != e->inverse;
+}
+
+uint32_t ssd1306_emulator_compare(const SSD1306_Emulator *e, const uint8_t *frame, uint8_t width, uint8_t pages, uint8_t column_offset)
+{
+    uint32_t differences = 0;
+    for (uint8_t page = 0; page < pages; page++)
+    {
+        for (uint8_t c = 0; c < width; c++)
+        {
+            if (e->gddram[page][column_offset + c] != frame[1 + page * width + c])
+                differences++;
+        }
+    }
+    return differences;
+}
+
+void ssd1306_emulator_print(const SSD1306_Emulator *e, FILE *f, uint8_t width, uint8_t height)
+{
+    for (uint8_t y = 0; y < height; y++)
+    {
+        for (uint8_t x = 0; x < width; x++)
+            fputc(ssd1306_emulator_pixel(e, x, y) ? '#' : '.', f);
+        fputc('\n', f);
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ * @file ssd1306_emulator.h
+ * @brief Host emulator of a SSD1306 controller: decodes the bytes written by the library
+ * into a simulated 128x64 GDDRAM and accounts the I2C bus time they take
+ * @author Iván Santiago
+ * @date 2023-08-12 17:48
+ */
+#ifndef SSD1306_EMULATOR_H_
+#define SSD1306_EMULATOR_H_
+
+#include <stdio.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * GDDRAM columns of the controller
+ */
+#define SSD1306_GDDRAM_COLUMNS 128
+/**
+ * GDDRAM pages of the controller
+ */
+#define SSD1306_GDDRAM_PAGES 8
+
+typedef struct ssd1306_emulator
+{
+    uint8_t gddram[SSD1306_GDDRAM_PAGES][SSD1306_GDDRAM_COLUMNS];
+
+    /** SSD1306_HORIZONTAL_ADDRESSING_MODE, SSD1306_VERTICAL_ADDRESSING_M0DE or SSD1306_PAGE_ADDRESING_MODE */
+    uint8_t addressing_mode;
+    uint8_t column_start;
+    uint8_t column_end;
+    uint8_t page_start;
+    uint8_t page_end;
+    /** GDDRAM pointer */
+    uint8_t column;
+    uint8_t page;
+
+    uint8_t start_line;
+    uint8_t multiplex_ratio;
+    uint8_t display_offset;
+    uint8_t com_pins;
+    uint8_t contrast;
+    uint8_t clock_divide;
+    uint8_t precharge;
+    uint8_t vcomh;
+    uint8_t charge_pump;
+    bool segment_remap;
+    bool com_remap;
+    bool inverse;
+    bool entire_display_on;
+    bool display_on;
+
+    /** Last scroll setup command (0x26, 0x27, 0x29 or 0x2A), 0 if none */
+    uint8_t scroll_command;
+    uint8_t scroll_start_page;
+    uint8_t scroll_end_page;
+    uint8_t scroll_interval;
+    uint8_t scroll_vertical_offset;
+    uint8_t scroll_area_top;
+    uint8_t scroll_area_rows;
+    bool scrolling;
+
+    /** Command being decoded and its parameters */
+    uint8_t command[7];
+    uint8_t command_length;
+    uint8_t command_expected;
+
+    /** I2C clock in Hz used for the bus time accounting */
+    uint32_t clock_hz;
+    /** Bus clocks of every transaction: start, address, payload and stop */
+    uint64_t bus_clocks;
+    uint32_t transactions;
+    uint32_t command_bytes;
+    uint32_t data_bytes;
+    /** Control bytes with an invalid value */
+    uint32_t errors;
+} SSD1306_Emulator;
+
+/**
+ * Emulator transport, the context must be a SSD1306_Emulator.
+ * Asynchronous transfers are decoded and completed on submit.
+ */
+extern const SSD1306_Transport ssd1306_emulator_transport;
+
+/**
+ * Sets a SSD1306_Emulator to the controller reset state with a zeroed GDDRAM
+ * @param e pointer to SSD1306_Emulator
+ * @param clock_hz I2C clock used for the bus time accounting
+ */
+void ssd1306_emulator_init(SSD1306_Emulator *e, uint32_t clock_hz);
+
+/**
+ * Decodes one I2C transaction: a control byte followed by commands or GDDRAM data
+ * @param e pointer to SSD1306_Emulator
+ * @param data bytes after the address byte
+ * @param length number of bytes
+ */
+void ssd1306_emulator_write(SSD1306_Emulator *e, const uint8_t *data, uint32_t length);
+
+/**
+ * Resets the bus counters of a SSD1306_Emulator
+ * @param e pointer to SSD1306_Emulator
+ */
+void ssd1306_emulator_reset_counters(SSD1306_Emulator *e);
+
+/**
+ * Bus time of the transactions decoded since the last counter reset
+ * @param e pointer to SSD1306_Emulator
+ * @return microseconds at e->clock_hz
+ */
+uint64_t ssd1306_emulator_bus_us(const SSD1306_Emulator *e);
+
+/**
+ * Reads a pixel of the panel, applying start line, display offset, re-maps and inverse display
+ * @param e pointer to SSD1306_Emulator
+ * @param x panel column
+ * @param y panel row
+ * @return true if the pixel is lit
+ */
+bool ssd1306_emulator_pixel(const SSD1306_Emulator *e, uint8_t x, uint8_t y);
+
+/**
+ * Counts the GDDRAM bytes that differ from a frame
+ * @param e pointer to SSD1306_Emulator
+ * @param frame frame with the control byte at index 0
+ * @param width columns per page of frame
+ * @param pages number of pages of frame
+ * @param column_offset first GDDRAM column of frame
+ * @return number of different bytes, 0 if the GDDRAM matches frame
+ */
+uint32_t ssd1306_emulator_compare(const SSD1306_Emulator *e, const uint8_t *frame, uint8_t width, uint8_t pages, uint8_t column_offset);
+
+/**
+ * Prints the panel as text, one character per pixel
+ * @param e pointer to SSD1306_Emulator
+ * @param f output stream
+ * @param width panel columns
+ * @param height panel rows
+ */
+void ssd1306_emulator_print(const SSD1306_Emulator *e, FILE *f, uint8_t width, uint8_t height);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,23 @@
+#include "ssd1306_font.h"
+#include "ssd1306_font5x7.h"
+#include "ssd1306_font7x9.h"
+#include "ssd1306_font7x11.h"
+#include "ssd1306_font7seg.h"
+#include <stddef.h>
+#include <string.h>
+
+const SSD1306_Font *const ssd1306_fonts[] = {
+    &ssd1306_font5x7,
+    &ssd1306_font7x9,
+    &ssd1306_font7x11,
+    &ssd1306_font7segment,
+    NULL,
+};
+
+const SSD1306_Font *ssd1306_find_font(const char *name)
+{
+    for (const SSD1306_Font *const *f = ssd1306_fonts; *f != NULL; f++)
+        if (strcmp((*f)->name, name) == 0)
+            return *f;
+    return NULL;
+}
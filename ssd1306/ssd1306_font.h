@@ -9,8 +9,34 @@
 
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Glyph pages stored as in the frame: page k of a glyph at font_array + vertical_offsets[k - 1]
+ * + character_offset[glyph], page 0 at font_array + character_offset[glyph]
+ */
+#define SSD1306_FONT_RAW 0
+/**
+ * Glyphs compressed one by one: the glyph at font_array + character_offset[glyph] is a stream of
+ * its pages one after the other, each page width bytes long, made of runs:
+ * 0nnnnnnn followed by n + 1 bytes copied as they are,
+ * 10nnnnnn standing for n + 1 bytes 0x00,
+ * 11nnnnnn followed by a byte repeated n + 1 times.
+ * Runs may cross pages, vertical_offsets is not used
+ */
+#define SSD1306_FONT_RLE 1
+
+/**
+ * Font in the page format of the SSD1306. Glyphs are indexed from 0: the characters
+ * first_character to last_character come first and are found in constant time, the glyphs
+ * of codepoints follow them in the same order
+ */
 typedef struct ssd1306_font
 {
+    /** Name the font is found by in the registry */
+    const char *name;
     const char first_character;
     const char last_character;
     const char overflow_character;
@@ -20,5 +46,27 @@ typedef struct ssd1306_font
     const uint8_t character_height;
     const uint32_t *vertical_offsets;
     const uint8_t character_spacing;
+    /** Unicode codepoints of the glyphs after last_character, sorted ascending, NULL if none */
+    const uint16_t *codepoints;
+    const uint16_t codepoint_count;
+    /** Glyph storage: SSD1306_FONT_RAW or SSD1306_FONT_RLE */
+    const uint8_t encoding;
 } SSD1306_Font;
+
+/**
+ * Fonts of the library, terminated by NULL. Fonts and their tables are const and stay in
+ * flash, a font is linked only when it or the registry is referenced
+ */
+extern const SSD1306_Font *const ssd1306_fonts[];
+
+/**
+ * Finds a font of the library by name
+ * @param name font name: "5x7", "7x9", "7x11" or "7segment"
+ * @return the font, NULL if there is no font with that name
+ */
+const SSD1306_Font *ssd1306_find_font(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
 #endif
\ No newline at end of file
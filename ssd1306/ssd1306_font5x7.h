@@ -3,60 +3,16 @@
 
 #include "ssd1306_font.h"
 
-const uint8_t font_5x7[412] = {
-    0x00, 0x00, 0x00, 0x5f, 0x00, 0x03, 0x00, 0x03, 0x14, 0x3e, 0x14, 0x3e, 0x14, 0x46, 0x49, 0x7f,
-    0x49, 0x31, 0x23, 0x13, 0x08, 0x64, 0x62, 0x36, 0x49, 0x55, 0x22, 0x50, 0x03, 0x00, 0x3e, 0x41,
-    0x00, 0x00, 0x41, 0x3e, 0x00, 0x08, 0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x40, 0x20, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x40, 0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x3e, 0x51, 0x49, 0x45, 0x3e, 0x44,
-    0x42, 0x7f, 0x40, 0x40, 0x62, 0x51, 0x49, 0x49, 0x46, 0x22, 0x41, 0x49, 0x49, 0x36, 0x18, 0x14,
-    0x12, 0x11, 0x7f, 0x27, 0x45, 0x45, 0x45, 0x39, 0x3e, 0x49, 0x49, 0x49, 0x32, 0x01, 0x71, 0x09,
-    0x05, 0x03, 0x36, 0x49, 0x49, 0x49, 0x36, 0x26, 0x49, 0x49, 0x49, 0x3e, 0x22, 0x00, 0x40, 0x22,
-    0x08, 0x14, 0x22, 0x14, 0x14, 0x14, 0x14, 0x14, 0x22, 0x14, 0x08, 0x02, 0x01, 0x51, 0x09, 0x06,
-    0x3e, 0x41, 0x49, 0x55, 0x5e, 0x7e, 0x09, 0x09, 0x09, 0x7f, 0x7f, 0x49, 0x49, 0x49, 0x36, 0x3e,
-    0x41, 0x41, 0x41, 0x22, 0x7f, 0x41, 0x41, 0x41, 0x3e, 0x7f, 0x49, 0x49, 0x49, 0x41, 0x7f, 0x09,
-    0x09, 0x09, 0x01, 0x3e, 0x41, 0x41, 0x51, 0x32, 0x7f, 0x08, 0x08, 0x08, 0x7f, 0x41, 0x41, 0x7f,
-    0x41, 0x41, 0x20, 0x40, 0x40, 0x41, 0x3f, 0x7f, 0x08, 0x14, 0x22, 0x41, 0x7f, 0x40, 0x40, 0x40,
-    0x40, 0x7f, 0x02, 0x04, 0x02, 0x7f, 0x7f, 0x04, 0x08, 0x10, 0x7f, 0x3e, 0x41, 0x41, 0x41, 0x3e,
-    0x7f, 0x09, 0x09, 0x09, 0x06, 0x3e, 0x41, 0x51, 0x21, 0x5e, 0x7f, 0x09, 0x09, 0x09, 0x76, 0x26,
-    0x49, 0x49, 0x49, 0x32, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x3f, 0x40, 0x40, 0x40, 0x3f, 0x1f, 0x20,
-    0x40, 0x20, 0x1f, 0x3f, 0x40, 0x30, 0x40, 0x3f, 0x63, 0x14, 0x08, 0x14, 0x63, 0x03, 0x04, 0x78,
-    0x04, 0x03, 0x61, 0x51, 0x49, 0x45, 0x43, 0x7f, 0x41, 0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00,
-    0x41, 0x7f, 0x04, 0x02, 0x01, 0x02, 0x04, 0x40, 0x40, 0x40, 0x40, 0x40, 0x01, 0x02, 0x20, 0x54,
-    0x54, 0x78, 0x7f, 0x48, 0x48, 0x30, 0x38, 0x44, 0x44, 0x28, 0x30, 0x48, 0x48, 0x7f, 0x38, 0x54,
-    0x54, 0x18, 0x7e, 0x09, 0x09, 0x02, 0x4c, 0x52, 0x52, 0x3e, 0x7f, 0x08, 0x08, 0x70, 0x00, 0x7a,
-    0x00, 0x20, 0x40, 0x3a, 0x7f, 0x08, 0x14, 0x62, 0x00, 0x3f, 0x40, 0x7c, 0x04, 0x7c, 0x04, 0x78,
-    0x7c, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x38, 0x7c, 0x12, 0x12, 0x0c, 0x0c, 0x12, 0x12, 0x7c,
-    0x7c, 0x08, 0x04, 0x04, 0x48, 0x54, 0x54, 0x24, 0x04, 0x3f, 0x44, 0x44, 0x3c, 0x40, 0x40, 0x7c,
-    0x1c, 0x20, 0x40, 0x20, 0x1c, 0x3c, 0x40, 0x20, 0x40, 0x3c, 0x6c, 0x10, 0x10, 0x6c, 0x0c, 0x50,
-    0x50, 0x3c, 0x64, 0x54, 0x54, 0x4c, 0x08, 0x36, 0x41, 0x41, 0x00, 0x00, 0x3e, 0x00, 0x00, 0x41,
-    0x41, 0x36, 0x08, 0x08, 0x04, 0x08, 0x04, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f};
+#ifdef __cplusplus
+extern "C" {
+#endif
 
-const uint32_t font5x7_character_offset[96] = {
-    0, 3, 5, 8, 13, 18, 23, 28, 30, 33, 36, 39, 44, 46, 51, 53,
-    58, 63, 68, 73, 78, 83, 88, 93, 98, 103, 108, 110, 112, 115, 120, 123,
-    128, 133, 138, 143, 148, 153, 158, 163, 168, 173, 178, 183, 188, 193, 198, 203,
-    208, 213, 218, 223, 228, 233, 238, 243, 248, 253, 258, 263, 266, 271, 274, 279,
-    284, 286, 290, 294, 298, 302, 306, 310, 314, 318, 321, 324, 328, 331, 336, 340,
-    344, 348, 352, 356, 360, 364, 368, 373, 378, 382, 386, 390, 395, 398, 403, 407};
+/**
+ * 5x7 pixels proportional font, ASCII 32 to 126 plus the degree, micro and ohm signs and arrows
+ */
+extern const SSD1306_Font ssd1306_font5x7;
 
-const uint8_t font5x7_character_width[96] = {
-    3, 2, 3, 5, 5, 5, 5, 2, 3, 3, 3, 5, 2, 5, 2, 5,
-    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 3, 5, 3, 5,
-    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
-    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
-    2, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 4, 3, 5, 4, 4,
-    4, 4, 4, 4, 4, 4, 5, 5, 4, 4, 4, 5, 3, 5, 4, 5};
-
-const uint32_t font5x7_vertical_offsets[1] = {0};
-
-SSD1306_Font ssd1306_font5x7 = {
-    .first_character = 32,
-    .last_character = 127,
-    .overflow_character = 127,
-    .font_array = font_5x7,
-    .character_offset = font5x7_character_offset,
-    .character_width = font5x7_character_width,
-    .character_height = 1u,
-    .vertical_offsets = font5x7_vertical_offsets,
-    .character_spacing = 1u};
-#endif
\ No newline at end of file
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,53 @@
+#include "ssd1306_font7seg.h"
+
+static const uint8_t font_7segment[506] = {
+    0x8e, 0x00, 0x38, 0xc2, 0x7c, 0x00, 0x38, 0x05, 0xe0, 0xf0, 0xf8, 0xf0, 0xe4, 0x0e, 0xc7, 0x1f,
+    0x0a, 0x0e, 0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0x1f, 0x3f, 0x7f, 0x3f, 0x1f, 0x89, 0x09, 0x1f, 0x3f,
+    0x7f, 0x3f, 0x1f, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x89, 0x0a, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x03,
+    0x07, 0x0f, 0x07, 0x13, 0x38, 0xc7, 0x7c, 0x05, 0x38, 0x13, 0x07, 0x0f, 0x07, 0x03, 0x8e, 0x04,
+    0xf8, 0xfc, 0xfe, 0xfc, 0xf8, 0x8e, 0x04, 0x1f, 0x3f, 0x7f, 0x3f, 0x1f, 0x8e, 0x04, 0xfc, 0xfe,
+    0xff, 0xfe, 0xfc, 0x8e, 0x04, 0x0f, 0x1f, 0x3f, 0x1f, 0x0f, 0x80, 0x01, 0x04, 0x0e, 0xca, 0x1f,
+    0x05, 0x0e, 0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0x83, 0x01, 0x80, 0xc0, 0xc7, 0xe0, 0x0b, 0xc0, 0x9f,
+    0x3f, 0x7f, 0x3f, 0x1f, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x01, 0xc7, 0x03, 0x00, 0x01, 0x84, 0x05,
+    0x03, 0x07, 0x0f, 0x07, 0x13, 0x38, 0xca, 0x7c, 0x02, 0x38, 0x10, 0x00, 0x80, 0x01, 0x04, 0x0e,
+    0xca, 0x1f, 0x08, 0x0e, 0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0x00, 0x80, 0xc0, 0xca, 0xe0, 0x05, 0xc0,
+    0x9f, 0x3f, 0x7f, 0x3f, 0x1f, 0x81, 0x00, 0x01, 0xca, 0x03, 0x08, 0x01, 0xfc, 0xfe, 0xff, 0xfe,
+    0xfc, 0x00, 0x10, 0x38, 0xca, 0x7c, 0x05, 0x38, 0x13, 0x07, 0x0f, 0x07, 0x03, 0x04, 0xf8, 0xfc,
+    0xfe, 0xfc, 0xf8, 0x89, 0x0a, 0xf8, 0xfc, 0xfe, 0xfc, 0xf8, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f, 0xc0,
+    0xc7, 0xe0, 0x05, 0xc0, 0x9f, 0x3f, 0x7f, 0x3f, 0x1f, 0x84, 0x00, 0x01, 0xc7, 0x03, 0x05, 0x01,
+    0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x8e, 0x04, 0x0f, 0x1f, 0x3f, 0x1f, 0x0f, 0x05, 0xe0, 0xf0, 0xf8,
+    0xf0, 0xe4, 0x0e, 0xca, 0x1f, 0x08, 0x0e, 0x04, 0x00, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f, 0xc0, 0xc7,
+    0xe0, 0x01, 0xc0, 0x80, 0x88, 0x00, 0x01, 0xc7, 0x03, 0x08, 0x01, 0xfc, 0xfe, 0xff, 0xfe, 0xfc,
+    0x00, 0x10, 0x38, 0xca, 0x7c, 0x05, 0x38, 0x13, 0x07, 0x0f, 0x07, 0x03, 0x05, 0xe0, 0xf0, 0xf8,
+    0xf0, 0xe4, 0x0e, 0xca, 0x1f, 0x08, 0x0e, 0x04, 0x00, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f, 0xc0, 0xc7,
+    0xe0, 0x01, 0xc0, 0x80, 0x83, 0x05, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x01, 0xc7, 0x03, 0x0b, 0x01,
+    0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x03, 0x07, 0x0f, 0x07, 0x13, 0x38, 0xc7, 0x7c, 0x05, 0x38, 0x13,
+    0x07, 0x0f, 0x07, 0x03, 0x80, 0x01, 0x04, 0x0e, 0xca, 0x1f, 0x05, 0x0e, 0xe4, 0xf0, 0xf8, 0xf0,
+    0xe0, 0x8e, 0x04, 0x1f, 0x3f, 0x7f, 0x3f, 0x1f, 0x8e, 0x04, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x8e,
+    0x04, 0x0f, 0x1f, 0x3f, 0x1f, 0x0f, 0x05, 0xe0, 0xf0, 0xf8, 0xf0, 0xe4, 0x0e, 0xc7, 0x1f, 0x0b,
+    0x0e, 0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f, 0xc0, 0xc7, 0xe0, 0x0b, 0xc0,
+    0x9f, 0x3f, 0x7f, 0x3f, 0x1f, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x01, 0xc7, 0x03, 0x0b, 0x01, 0xfc,
+    0xfe, 0xff, 0xfe, 0xfc, 0x03, 0x07, 0x0f, 0x07, 0x13, 0x38, 0xc7, 0x7c, 0x05, 0x38, 0x13, 0x07,
+    0x0f, 0x07, 0x03, 0x05, 0xe0, 0xf0, 0xf8, 0xf0, 0xe4, 0x0e, 0xc7, 0x1f, 0x0b, 0x0e, 0xe4, 0xf0,
+    0xf8, 0xf0, 0xe0, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f, 0xc0, 0xc7, 0xe0, 0x05, 0xc0, 0x9f, 0x3f, 0x7f,
+    0x3f, 0x1f, 0x84, 0x00, 0x01, 0xc7, 0x03, 0x08, 0x01, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x00, 0x10,
+    0x38, 0xca, 0x7c, 0x05, 0x38, 0x13, 0x07, 0x0f, 0x07, 0x03, 0x80, 0xc2, 0x80, 0x80, 0x00, 0x07,
+    0xc2, 0x0f, 0x01, 0x07, 0x70, 0xc2, 0xf8, 0x00, 0x70, 0x84};
+
+static const uint32_t font7segment_character_offset[13] = {
+    0, 7, 7, 62, 90, 140, 189, 236, 284, 340, 374, 435, 490};
+
+static const uint8_t font7segment_character_width[13] = {
+    5, 0, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 5};
+
+const SSD1306_Font ssd1306_font7segment = {
+    .name = "7segment",
+    .first_character = 46,
+    .last_character = 58,
+    .overflow_character = 47,
+    .font_array = font_7segment,
+    .character_offset = font7segment_character_offset,
+    .character_width = font7segment_character_width,
+    .character_height = 4u,
+    .character_spacing = 3u,
+    .encoding = SSD1306_FONT_RLE};
@@ -3,75 +3,16 @@
 
 #include "ssd1306_font.h"
 
-const uint8_t font_7segment[840] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xf0, 0xf8, 0xf0, 0xe4, 0x0e, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,
-    0x1f, 0x1f, 0x1f, 0x0e, 0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xfc, 0xfe, 0xfc, 0xf8, 0x00, 0x04, 0x0e,
-    0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x0e, 0xe4, 0xf0, 0xf8, 0xf0,
-    0xe0, 0x00, 0x04, 0x0e, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x0e,
-    0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0xf8, 0xfc, 0xfe, 0xfc, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0xf8, 0xfc, 0xfe, 0xfc, 0xf8, 0xe0, 0xf0, 0xf8, 0xf0, 0xe4, 0x0e, 0x1f,
-    0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x0e, 0x04, 0x00, 0xe0, 0xf0, 0xf8,
-    0xf0, 0xe4, 0x0e, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x0e, 0x04,
-    0x00, 0x00, 0x04, 0x0e, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x0e,
-    0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0xe0, 0xf0, 0xf8, 0xf0, 0xe4, 0x0e, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,
-    0x1f, 0x1f, 0x1f, 0x0e, 0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0xe0, 0xf0, 0xf8, 0xf0, 0xe4, 0x0e, 0x1f,
-    0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x0e, 0xe4, 0xf0, 0xf8, 0xf0, 0xe0, 0x00, 0x80, 0x80,
-    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x3f, 0x7f, 0x3f, 0x1f, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x3f, 0x7f, 0x3f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x3f, 0x7f, 0x3f, 0x1f, 0x00,
-    0x00, 0x00, 0x00, 0x80, 0xc0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xc0, 0x9f, 0x3f,
-    0x7f, 0x3f, 0x1f, 0x00, 0x80, 0xc0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0,
-    0xe0, 0xc0, 0x9f, 0x3f, 0x7f, 0x3f, 0x1f, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f, 0xc0, 0xe0, 0xe0, 0xe0,
-    0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xc0, 0x9f, 0x3f, 0x7f, 0x3f, 0x1f, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f,
-    0xc0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xc0, 0x80, 0x00, 0x00, 0x00, 0x00, 0x1f,
-    0x3f, 0x7f, 0x3f, 0x9f, 0xc0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xc0, 0x80, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x1f, 0x3f, 0x7f, 0x3f, 0x1f, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f, 0xc0, 0xe0, 0xe0, 0xe0,
-    0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xc0, 0x9f, 0x3f, 0x7f, 0x3f, 0x1f, 0x1f, 0x3f, 0x7f, 0x3f, 0x9f,
-    0xc0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xc0, 0x9f, 0x3f, 0x7f, 0x3f, 0x1f, 0x07,
-    0x0f, 0x0f, 0x0f, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xfe, 0xff, 0xfe,
-    0xfc, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
-    0x03, 0x03, 0x03, 0x01, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03,
-    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0xfc, 0xfe, 0xff, 0xfe,
-    0xfc, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01,
-    0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x01, 0x03,
-    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0xfc, 0xfe, 0xff, 0xfe,
-    0xfc, 0x70, 0xf8, 0xf8, 0xf8, 0x70, 0x38, 0x7c, 0x7c, 0x7c, 0x38, 0x03, 0x07, 0x0f, 0x07, 0x13,
-    0x38, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x38, 0x13, 0x07, 0x0f, 0x07, 0x03, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x1f,
-    0x3f, 0x1f, 0x0f, 0x03, 0x07, 0x0f, 0x07, 0x13, 0x38, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c,
-    0x7c, 0x7c, 0x7c, 0x7c, 0x38, 0x10, 0x00, 0x00, 0x10, 0x38, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c,
-    0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x38, 0x13, 0x07, 0x0f, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x1f, 0x3f, 0x1f, 0x0f, 0x00,
-    0x10, 0x38, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x38, 0x13, 0x07,
-    0x0f, 0x07, 0x03, 0x03, 0x07, 0x0f, 0x07, 0x13, 0x38, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c,
-    0x7c, 0x38, 0x13, 0x07, 0x0f, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x1f, 0x3f, 0x1f, 0x0f, 0x03, 0x07, 0x0f, 0x07, 0x13,
-    0x38, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x38, 0x13, 0x07, 0x0f, 0x07, 0x03, 0x00,
-    0x10, 0x38, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x7c, 0x38, 0x13, 0x07,
-    0x0f, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00};
+#ifdef __cplusplus
+extern "C" {
+#endif
 
-const uint32_t font7segment_character_offset[13] = {0, 26, 5, 25, 45, 65, 85, 105, 125, 145, 165, 185, 205};
+/**
+ * 32 pixels high seven segment font with the characters . / 0-9 :
+ */
+extern const SSD1306_Font ssd1306_font7segment;
 
-const uint8_t font7segment_character_width[13] = {5, 0, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 5};
-
-const uint32_t font7segment_vertical_offsets[3] = {210u, 420u, 630u};
-
-SSD1306_Font ssd1306_font7segment = {
-    .first_character = '.',
-    .last_character = ':',
-    .overflow_character = '/',
-    .font_array = font_7segment,
-    .character_offset = font7segment_character_offset,
-    .character_width = font7segment_character_width,
-    .character_height = 4u,
-    .vertical_offsets = font7segment_vertical_offsets,
-    .character_spacing = 3u};
-#endif
\ No newline at end of file
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,109 @@
+#include "ssd1306_font7x11.h"
+
+static const uint8_t font_7x11[1208] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x07, 0x00, 0x07, 0x88, 0x88, 0xff, 0x88, 0xff, 0x88,
+    0x88, 0x1c, 0x22, 0x22, 0xff, 0x22, 0x22, 0xc4, 0x08, 0x94, 0x48, 0x20, 0x90, 0x48, 0x84, 0xc0,
+    0x2e, 0x51, 0x89, 0x06, 0x00, 0x80, 0x07, 0x00, 0xf8, 0x04, 0x02, 0x01, 0x01, 0x01, 0x01, 0x02,
+    0x04, 0xf8, 0x04, 0x88, 0x50, 0xfe, 0x50, 0x88, 0x04, 0x20, 0x20, 0x20, 0xfc, 0x20, 0x20, 0x20,
+    0x00, 0x00, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x20, 0x18,
+    0x06, 0x01, 0xfc, 0x82, 0x41, 0x21, 0x11, 0x0a, 0xfc, 0x08, 0x04, 0x02, 0xff, 0x00, 0x00, 0x00,
+    0x0c, 0x02, 0x81, 0x41, 0x21, 0x12, 0x0c, 0x02, 0x21, 0x21, 0x21, 0x21, 0x21, 0xde, 0x60, 0x50,
+    0x48, 0x44, 0x42, 0xff, 0x40, 0x1f, 0x11, 0x11, 0x11, 0x11, 0x21, 0xc1, 0xfe, 0x21, 0x21, 0x21,
+    0x21, 0x21, 0xc2, 0x01, 0x01, 0x01, 0xc1, 0x31, 0x0d, 0x03, 0xde, 0x21, 0x21, 0x21, 0x21, 0x21,
+    0xde, 0x1e, 0x21, 0x21, 0x21, 0x21, 0x21, 0xfe, 0x30, 0x30, 0x30, 0x30, 0x20, 0x50, 0x50, 0x88,
+    0x88, 0x04, 0x04, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x04, 0x04, 0x88, 0x88, 0x50, 0x50,
+    0x20, 0x04, 0x02, 0x01, 0xc1, 0x21, 0x12, 0x0c, 0xfc, 0x02, 0x71, 0x89, 0x89, 0x4a, 0xfc, 0xfc,
+    0x22, 0x21, 0x21, 0x21, 0x22, 0xfc, 0xff, 0x21, 0x21, 0x21, 0x21, 0x52, 0x8c, 0xfc, 0x02, 0x01,
+    0x01, 0x01, 0x01, 0x02, 0xff, 0x01, 0x01, 0x01, 0x02, 0x04, 0xf8, 0xff, 0x21, 0x21, 0x21, 0x21,
+    0x21, 0x01, 0xff, 0x21, 0x21, 0x21, 0x21, 0x21, 0x01, 0xfc, 0x02, 0x21, 0x21, 0x21, 0x21, 0xe2,
+    0xff, 0x20, 0x20, 0x20, 0x20, 0x20, 0xff, 0x01, 0x01, 0x01, 0xff, 0x01, 0x01, 0x01, 0x80, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x20, 0x50, 0x88, 0x04, 0x02, 0x01, 0xff, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0x06, 0x18, 0x20, 0x18, 0x06, 0xff, 0xff, 0x04, 0x18, 0x20, 0xc0, 0x00,
+    0xff, 0xfc, 0x02, 0x01, 0x01, 0x01, 0x02, 0xfc, 0xff, 0x21, 0x21, 0x21, 0x21, 0x21, 0x1e, 0xfc,
+    0x02, 0x41, 0x81, 0x01, 0x02, 0xfc, 0xff, 0x21, 0x21, 0x61, 0xa1, 0x21, 0x1e, 0x0c, 0x12, 0x21,
+    0x21, 0x21, 0x42, 0x84, 0x01, 0x01, 0x01, 0xff, 0x01, 0x01, 0x01, 0xff, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0xe0, 0x00, 0x00, 0xff,
+    0x01, 0x06, 0xd8, 0x20, 0xd8, 0x06, 0x01, 0x1f, 0x20, 0x20, 0x20, 0x20, 0x20, 0xff, 0x01, 0x81,
+    0x41, 0x21, 0x11, 0x0d, 0x03, 0xff, 0x01, 0x01, 0x01, 0x01, 0x01, 0x06, 0x18, 0x20, 0xc0, 0x00,
+    0x00, 0x01, 0x01, 0x01, 0x01, 0xff, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0xc0, 0x20, 0x10, 0x10, 0x10, 0x20, 0xf0, 0xff, 0x20, 0x10,
+    0x10, 0x10, 0x20, 0xc0, 0xc0, 0x20, 0x10, 0x10, 0x10, 0x10, 0x20, 0xc0, 0x20, 0x10, 0x10, 0x10,
+    0x20, 0xff, 0xc0, 0xa0, 0x90, 0x90, 0x90, 0xa0, 0xc0, 0xfc, 0x22, 0x21, 0x21, 0x21, 0x02, 0x04,
+    0xc0, 0x20, 0x10, 0x10, 0x10, 0x20, 0xf0, 0xff, 0x20, 0x10, 0x10, 0x10, 0x20, 0xc0, 0xf4, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xf4, 0xfc, 0x40, 0x40, 0x40, 0xa0, 0x10, 0x08, 0x01, 0xff, 0x00,
+    0xf0, 0x20, 0x10, 0xe0, 0x10, 0x10, 0xe0, 0xf0, 0x20, 0x10, 0x10, 0x10, 0x20, 0xc0, 0xc0, 0x20,
+    0x10, 0x10, 0x10, 0x20, 0xc0, 0xf0, 0x20, 0x10, 0x10, 0x10, 0x20, 0xc0, 0xc0, 0x20, 0x10, 0x10,
+    0x10, 0x20, 0xf0, 0xf0, 0x40, 0x20, 0x10, 0x10, 0x20, 0x60, 0x90, 0x90, 0x90, 0x90, 0x90, 0x20,
+    0x10, 0x10, 0xff, 0x10, 0x10, 0x10, 0x10, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x80, 0x00, 0x00, 0xf0, 0x10, 0x20, 0x40, 0x80,
+    0x40, 0x20, 0x10, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x10, 0x10, 0x10, 0x90, 0x50, 0x30,
+    0x10, 0x20, 0xd8, 0x06, 0x01, 0x01, 0x00, 0xff, 0x00, 0x01, 0x01, 0x06, 0xd8, 0x20, 0x20, 0x10,
+    0x10, 0x20, 0x40, 0x40, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x01, 0x02, 0x02,
+    0x07, 0x02, 0x02, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x02, 0x04, 0x04, 0x05,
+    0x02, 0x05, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x04, 0x04, 0x04, 0x02, 0x01, 0x00, 0x01, 0x00,
+    0x00, 0x03, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0a, 0x06, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02,
+    0x04, 0x04, 0x04, 0x02, 0x01, 0x04, 0x04, 0x04, 0x07, 0x04, 0x04, 0x04, 0x06, 0x05, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x02, 0x04, 0x04, 0x04, 0x04, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07,
+    0x00, 0x02, 0x04, 0x04, 0x04, 0x04, 0x02, 0x01, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x03, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x03, 0x02, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x03, 0x06, 0x06, 0x0a, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x04, 0x04, 0x04, 0x01, 0x07, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x07, 0x07, 0x04, 0x04, 0x04, 0x04, 0x02, 0x01, 0x01, 0x02, 0x04, 0x04, 0x04, 0x04, 0x02,
+    0x07, 0x04, 0x04, 0x04, 0x02, 0x01, 0x00, 0x07, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x07, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x04, 0x04, 0x04, 0x03, 0x07, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x07, 0x04, 0x04, 0x04, 0x07, 0x04, 0x04, 0x04, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02,
+    0x01, 0x07, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x07, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x07,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x01, 0x07, 0x01, 0x02, 0x04,
+    0x04, 0x04, 0x02, 0x01, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x04, 0x05,
+    0x02, 0x05, 0x07, 0x00, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x01,
+    0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x01, 0x00, 0x01,
+    0x02, 0x04, 0x02, 0x01, 0x00, 0x03, 0x04, 0x02, 0x01, 0x02, 0x04, 0x03, 0x04, 0x03, 0x00, 0x00,
+    0x00, 0x03, 0x04, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x01, 0x06, 0x05, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x07, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x07, 0x07, 0x02, 0x04, 0x04, 0x04, 0x02, 0x01,
+    0x01, 0x02, 0x04, 0x04, 0x04, 0x04, 0x02, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x07, 0x01, 0x02,
+    0x04, 0x04, 0x04, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x44, 0x44,
+    0x44, 0x22, 0x1f, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x03, 0x04, 0x00, 0x20, 0x40, 0x40,
+    0x20, 0x1f, 0x07, 0x00, 0x00, 0x00, 0x00, 0x01, 0x06, 0x00, 0x03, 0x04, 0x07, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02,
+    0x01, 0x7f, 0x02, 0x04, 0x04, 0x04, 0x02, 0x01, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x7f, 0x07,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x04, 0x04, 0x04, 0x04, 0x04, 0x03, 0x00, 0x00, 0x03, 0x04,
+    0x04, 0x04, 0x03, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x07, 0x00, 0x01, 0x02, 0x04, 0x02, 0x01,
+    0x00, 0x03, 0x04, 0x04, 0x03, 0x04, 0x04, 0x03, 0x04, 0x02, 0x01, 0x00, 0x01, 0x02, 0x04, 0x01,
+    0x22, 0x44, 0x44, 0x44, 0x22, 0x1f, 0x04, 0x06, 0x05, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x03,
+    0x04, 0x04, 0x00, 0x07, 0x00, 0x04, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07};
+
+static const uint32_t font7x11_character_offset[96] = {
+    0, 5, 7, 10, 17, 24, 31, 38, 40, 45, 50, 57, 64, 66, 73, 75,
+    82, 89, 96, 103, 110, 117, 124, 131, 138, 145, 152, 154, 156, 163, 170, 177,
+    184, 191, 198, 205, 212, 219, 226, 233, 240, 247, 254, 261, 268, 275, 282, 289,
+    296, 303, 310, 317, 324, 331, 338, 345, 352, 359, 366, 373, 378, 385, 390, 397,
+    404, 406, 413, 420, 427, 434, 441, 448, 455, 462, 465, 470, 477, 480, 487, 494,
+    501, 508, 515, 521, 528, 535, 542, 549, 556, 563, 570, 577, 582, 585, 590, 597};
+
+static const uint8_t font7x11_character_width[96] = {
+    5, 2, 3, 7, 7, 7, 7, 2, 5, 5, 7, 7, 2, 7, 2, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 2, 2, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 5, 7, 5, 7, 7,
+    2, 7, 7, 7, 7, 7, 7, 7, 7, 3, 5, 7, 3, 7, 7, 7,
+    7, 7, 6, 7, 7, 7, 7, 7, 7, 7, 7, 5, 3, 5, 7, 7};
+
+static const uint32_t font7x11_vertical_offsets[1] = {604u};
+
+const SSD1306_Font ssd1306_font7x11 = {
+    .name = "7x11",
+    .first_character = 32,
+    .last_character = 127,
+    .overflow_character = 127,
+    .font_array = font_7x11,
+    .character_offset = font7x11_character_offset,
+    .character_width = font7x11_character_width,
+    .character_height = 2u,
+    .vertical_offsets = font7x11_vertical_offsets,
+    .character_spacing = 1u};
@@ -0,0 +1,108 @@
+#include "ssd1306_font7x9.h"
+
+static const uint8_t font_7x9[1188] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x03, 0x00, 0x03, 0x44, 0x44, 0xff, 0x44, 0xff, 0x44,
+    0x44, 0x4c, 0x92, 0x92, 0xff, 0x92, 0x92, 0x64, 0x84, 0x4a, 0x24, 0x10, 0x48, 0xa4, 0x42, 0xe6,
+    0x19, 0x11, 0x29, 0x46, 0x80, 0x40, 0x03, 0x00, 0x7c, 0x82, 0x01, 0x01, 0x01, 0x01, 0x82, 0x7c,
+    0x92, 0x54, 0x38, 0xfe, 0x38, 0x54, 0x92, 0x10, 0x10, 0x10, 0xfe, 0x10, 0x10, 0x10, 0x00, 0x00,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02,
+    0x7c, 0x82, 0x01, 0x01, 0x01, 0x82, 0x7c, 0x04, 0x02, 0x01, 0xff, 0x00, 0x00, 0x00, 0x06, 0x81,
+    0x41, 0x21, 0x11, 0x0e, 0x00, 0x82, 0x11, 0x11, 0x11, 0x11, 0x11, 0xee, 0x30, 0x28, 0x24, 0x22,
+    0x21, 0xff, 0x20, 0xcf, 0x09, 0x09, 0x09, 0x09, 0x09, 0xf1, 0xfe, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0xe2, 0x01, 0x81, 0x41, 0x21, 0x11, 0x09, 0x07, 0xee, 0x11, 0x11, 0x11, 0x11, 0x11, 0xee, 0x8e,
+    0x11, 0x11, 0x11, 0x11, 0x11, 0xfe, 0x04, 0x00, 0x00, 0x04, 0x10, 0x28, 0x28, 0x44, 0x44, 0x82,
+    0x82, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x82, 0x82, 0x44, 0x44, 0x28, 0x28, 0x10, 0x06,
+    0x01, 0x01, 0x61, 0x11, 0x09, 0x06, 0xfe, 0x19, 0x25, 0x25, 0x79, 0x81, 0x7e, 0xf8, 0x16, 0x11,
+    0x11, 0x11, 0x16, 0xf8, 0xff, 0x11, 0x11, 0x11, 0x11, 0x11, 0xee, 0x7c, 0x82, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0xff, 0x01, 0x01, 0x01, 0x01, 0x82, 0x7c, 0xff, 0x11, 0x11, 0x11, 0x11, 0x11, 0x01,
+    0xff, 0x11, 0x11, 0x11, 0x11, 0x01, 0x01, 0xfe, 0x01, 0x11, 0x11, 0x11, 0x91, 0xf2, 0xff, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0xff, 0x01, 0x01, 0x01, 0xff, 0x01, 0x01, 0x01, 0xc1, 0x01, 0x01, 0x01,
+    0xff, 0x01, 0x01, 0xff, 0x10, 0x10, 0x28, 0x44, 0x82, 0x01, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xff, 0x02, 0x04, 0x08, 0x04, 0x02, 0xff, 0xff, 0x04, 0x08, 0x10, 0x20, 0x40, 0xff, 0xfe,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0xfe, 0xff, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x7c, 0x82, 0x11,
+    0x21, 0x41, 0x82, 0x7c, 0xff, 0x11, 0x11, 0x11, 0x31, 0x51, 0x8e, 0x8e, 0x11, 0x11, 0x11, 0x11,
+    0x11, 0xe2, 0x01, 0x01, 0x01, 0xff, 0x01, 0x01, 0x01, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x80, 0x7f,
+    0x0f, 0x30, 0xc0, 0x00, 0xc0, 0x30, 0x0f, 0x3f, 0xc0, 0x00, 0xf0, 0x00, 0xc0, 0x3f, 0x83, 0x44,
+    0x28, 0x10, 0x28, 0x44, 0x83, 0xcf, 0x10, 0x10, 0x10, 0x10, 0x10, 0xff, 0x81, 0x41, 0x21, 0x11,
+    0x09, 0x05, 0x03, 0xff, 0x01, 0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x01,
+    0x01, 0xff, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x02, 0xc8, 0x24, 0x24, 0x24, 0x24, 0x24, 0xf8, 0xff, 0x88, 0x04, 0x04, 0x04, 0x88, 0x70,
+    0x70, 0x88, 0x04, 0x04, 0x04, 0x04, 0x70, 0x88, 0x04, 0x04, 0x04, 0x88, 0xff, 0x70, 0xa8, 0x24,
+    0x24, 0x24, 0x28, 0x30, 0xfe, 0x11, 0x11, 0x11, 0x11, 0x01, 0x02, 0x70, 0x88, 0x04, 0x04, 0x04,
+    0x08, 0xfc, 0xff, 0x08, 0x04, 0x04, 0x04, 0x08, 0xf0, 0xfa, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf2,
+    0xff, 0x08, 0x14, 0x22, 0x41, 0x80, 0x01, 0xfe, 0x00, 0x80, 0xf8, 0x04, 0x04, 0x78, 0x04, 0x04,
+    0xf8, 0xfc, 0x08, 0x04, 0x04, 0x04, 0x08, 0xf0, 0x70, 0x88, 0x04, 0x04, 0x04, 0x88, 0x70, 0xfc,
+    0x88, 0x04, 0x04, 0x04, 0x88, 0x70, 0x70, 0x88, 0x04, 0x04, 0x04, 0x88, 0xfc, 0xfc, 0x10, 0x08,
+    0x04, 0x04, 0x04, 0x08, 0x98, 0x24, 0x24, 0x24, 0x24, 0x24, 0xc8, 0x04, 0x04, 0xff, 0x04, 0x04,
+    0xc0, 0x7c, 0x80, 0x00, 0x00, 0x00, 0x80, 0xfc, 0x0c, 0x30, 0xc0, 0x00, 0xc0, 0x30, 0x0c, 0xfc,
+    0x00, 0x00, 0xf0, 0x00, 0x00, 0xfc, 0x04, 0x88, 0x50, 0x20, 0x50, 0x88, 0x04, 0x7c, 0x80, 0x00,
+    0x00, 0x80, 0xfc, 0x04, 0x84, 0x44, 0x24, 0x14, 0x0c, 0x04, 0x10, 0x6c, 0x82, 0x01, 0xff, 0x00,
+    0x01, 0x82, 0x6c, 0x10, 0x10, 0x08, 0x08, 0x10, 0x20, 0x20, 0x10, 0x55, 0xaa, 0x55, 0xaa, 0x55,
+    0xaa, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x01, 0x01, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x01, 0x00,
+    0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x08, 0x09,
+    0x09, 0x09, 0x09, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x06, 0x08, 0x08,
+    0x08, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x0f, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x0f, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x04,
+    0x08, 0x09, 0x09, 0x08, 0x07, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01,
+    0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x01};
+
+static const uint32_t font7x9_character_offset[96] = {
+    0, 5, 7, 10, 17, 24, 31, 38, 40, 44, 48, 55, 62, 64, 71, 73,
+    80, 87, 94, 101, 108, 115, 122, 129, 136, 143, 150, 152, 154, 161, 168, 175,
+    182, 189, 196, 203, 210, 217, 224, 231, 238, 245, 252, 259, 266, 273, 280, 287,
+    294, 301, 308, 315, 322, 329, 336, 343, 350, 357, 364, 371, 375, 382, 386, 393,
+    400, 402, 409, 416, 422, 429, 436, 443, 450, 457, 459, 464, 470, 474, 481, 488,
+    495, 502, 509, 516, 523, 529, 536, 543, 550, 557, 563, 570, 574, 576, 580, 587};
+
+static const uint8_t font7x9_character_width[96] = {
+    5, 2, 3, 7, 7, 7, 7, 2, 4, 4, 7, 7, 2, 7, 2, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 2, 2, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 4, 7, 4, 7, 7,
+    2, 7, 7, 6, 7, 7, 7, 7, 7, 2, 5, 6, 4, 7, 7, 7,
+    7, 7, 7, 7, 6, 7, 7, 7, 7, 6, 7, 4, 2, 4, 7, 7};
+
+static const uint32_t font7x9_vertical_offsets[1] = {594u};
+
+const SSD1306_Font ssd1306_font7x9 = {
+    .name = "7x9",
+    .first_character = 32,
+    .last_character = 127,
+    .overflow_character = 127,
+    .font_array = font_7x9,
+    .character_offset = font7x9_character_offset,
+    .character_width = font7x9_character_width,
+    .character_height = 2u,
+    .vertical_offsets = font7x9_vertical_offsets,
+    .character_spacing = 1u};
@@ -0,0 +1,196 @@
+#include "ssd1306_pico.h"
+#include "hardware/gpio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+
+static SSD1306_I2C_Context ssd1306_default_i2c = {
+    .i2c = SSD1306_I2C,
+    .address = SSD1306_ADDRESS};
+
+static void ssd1306_i2c_write(void *context, const uint8_t *data, uint32_t length)
+{
+    SSD1306_I2C_Context *c = context;
+    i2c_write_blocking(c->i2c, c->address, data, length, false);
+}
+
+static void ssd1306_i2c_flush(void *context)
+{
+    (void)context;
+}
+
+const SSD1306_Transport ssd1306_i2c_transport = {
+    .write_commands = ssd1306_i2c_write,
+    .write_data = ssd1306_i2c_write,
+    .submit_async = NULL,
+    .flush = ssd1306_i2c_flush};
+
+static SSD1306_I2C_DMA_Context *ssd1306_i2c_dma_contexts[2];
+
+static void ssd1306_i2c_dma_flush(void *context)
+{
+    SSD1306_I2C_DMA_Context *c = context;
+    while (c->busy)
+        tight_loop_contents();
+}
+
+static void ssd1306_i2c_dma_write(void *context, const uint8_t *data, uint32_t length)
+{
+    SSD1306_I2C_DMA_Context *c = context;
+    ssd1306_i2c_dma_flush(c);
+    i2c_write_blocking(c->i2c, c->address, data, length, false);
+}
+
+static bool ssd1306_i2c_dma_submit_async(void *context, const uint8_t *data, uint32_t length, SSD1306_Callback callback, void *user_data)
+{
+    SSD1306_I2C_DMA_Context *c = context;
+    if (length == 0 || length > SSD1306_MAX_FRAME_LENGTH)
+        return false;
+    ssd1306_i2c_dma_flush(c);
+    for (uint32_t i = 0; i < length; i++)
+        c->commands[i] = data[i];
+    c->commands[length - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    c->callback = callback;
+    c->user_data = user_data;
+    c->busy = true;
+
+    i2c_hw_t *hw = i2c_get_hw(c->i2c);
+    hw->enable = 0;
+    hw->tar = c->address;
+    hw->enable = 1;
+    (void)hw->clr_stop_det;
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+
+    dma_channel_config config = dma_channel_get_default_config(c->dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(c->i2c, true));
+    dma_channel_configure(c->dma_channel, &config, &hw->data_cmd, c->commands, length, true);
+    return true;
+}
+
+/**
+ * DMA_IRQ_0 handler: the last byte is in the TX FIFO, waits for the STOP condition
+ */
+static void ssd1306_i2c_dma_irq_handler(void)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        SSD1306_I2C_DMA_Context *c = ssd1306_i2c_dma_contexts[i];
+        if (c != NULL && dma_channel_get_irq0_status(c->dma_channel))
+        {
+            dma_channel_acknowledge_irq0(c->dma_channel);
+            i2c_get_hw(c->i2c)->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS;
+        }
+    }
+}
+
+/**
+ * I2C interrupt handler: the STOP condition ends the asynchronous transfer
+ */
+static void ssd1306_i2c_stop_irq_handler(void)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        SSD1306_I2C_DMA_Context *c = ssd1306_i2c_dma_contexts[i];
+        if (c == NULL)
+            continue;
+        i2c_hw_t *hw = i2c_get_hw(c->i2c);
+        if (c->busy && (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS))
+        {
+            (void)hw->clr_stop_det;
+            hw->intr_mask = 0;
+            hw->dma_cr = 0;
+            c->busy = false;
+            if (c->callback != NULL)
+                c->callback(c->user_data);
+        }
+    }
+}
+
+const SSD1306_Transport ssd1306_i2c_dma_transport = {
+    .write_commands = ssd1306_i2c_dma_write,
+    .write_data = ssd1306_i2c_dma_write,
+    .submit_async = ssd1306_i2c_dma_submit_async,
+    .flush = ssd1306_i2c_dma_flush};
+
+bool ssd1306_i2c_dma_context_init(SSD1306_I2C_DMA_Context *c, i2c_inst_t *i2c, uint8_t address)
+{
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0)
+        return false;
+    c->i2c = i2c;
+    c->address = address;
+    c->dma_channel = channel;
+    c->busy = false;
+    c->callback = NULL;
+    c->user_data = NULL;
+
+    uint32_t index = i2c_hw_index(i2c);
+    ssd1306_i2c_dma_contexts[index] = c;
+    i2c_get_hw(i2c)->intr_mask = 0;
+    irq_add_shared_handler(DMA_IRQ_0, ssd1306_i2c_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    irq_add_shared_handler(I2C0_IRQ + index, ssd1306_i2c_stop_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(I2C0_IRQ + index, true);
+    dma_channel_set_irq0_enabled(channel, true);
+    return true;
+}
+
+static void ssd1306_spi_write(SSD1306_SPI_Context *c, const uint8_t *data, uint32_t length, bool dc)
+{
+    gpio_put(c->dc_pin, dc);
+    gpio_put(c->cs_pin, 0);
+    spi_write_blocking(c->spi, data + 1, length - 1);
+    gpio_put(c->cs_pin, 1);
+}
+
+static void ssd1306_spi_write_commands(void *context, const uint8_t *commands, uint32_t length)
+{
+    ssd1306_spi_write(context, commands, length, 0);
+}
+
+static void ssd1306_spi_write_data(void *context, const uint8_t *data, uint32_t length)
+{
+    ssd1306_spi_write(context, data, length, 1);
+}
+
+static void ssd1306_spi_flush(void *context)
+{
+    (void)context;
+}
+
+const SSD1306_Transport ssd1306_spi_transport = {
+    .write_commands = ssd1306_spi_write_commands,
+    .write_data = ssd1306_spi_write_data,
+    .submit_async = NULL,
+    .flush = ssd1306_spi_flush};
+
+void ssd1306_spi_context_init(SSD1306_SPI_Context *s)
+{
+    gpio_init(s->cs_pin);
+    gpio_set_dir(s->cs_pin, GPIO_OUT);
+    gpio_put(s->cs_pin, 1);
+    gpio_init(s->dc_pin);
+    gpio_set_dir(s->dc_pin, GPIO_OUT);
+}
+
+static SSD1306_Pipeline *ssd1306_core1_pipeline;
+
+static void ssd1306_core1_entry(void)
+{
+    ssd1306_pipeline_run(ssd1306_core1_pipeline);
+}
+
+void ssd1306_pipeline_launch_core1(SSD1306_Pipeline *p)
+{
+    ssd1306_core1_pipeline = p;
+    multicore_launch_core1(ssd1306_core1_entry);
+}
+
+SSD1306_Display *ssd1306_init(void)
+{
+    return ssd1306_init_transport(&ssd1306_i2c_transport, &ssd1306_default_i2c);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file ssd1306_pico.h
+ * @brief I2C and SPI transports of the ssd1306 library for the Raspberry Pi Pico SDK
+ * @author Iván Santiago
+ * @date 2023-08-06 18:40
+ */
+#ifndef SSD1306_PICO_H_
+#define SSD1306_PICO_H_
+
+#include "hardware/i2c.h"
+#include "hardware/spi.h"
+#include "ssd1306.h"
+#include "ssd1306_pipeline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * I2C instance used by ssd1306_init
+ */
+#define SSD1306_I2C i2c0
+/**
+ * SSD1306 I2C address used by ssd1306_init
+ */
+#define SSD1306_ADDRESS 0x3C
+
+/**
+ * Context of the I2C transport
+ */
+typedef struct ssd1306_i2c_context
+{
+    i2c_inst_t *i2c;
+    uint8_t address;
+} SSD1306_I2C_Context;
+
+/**
+ * Context of the I2C transport that writes GDDRAM data asynchronously through DMA
+ */
+typedef struct ssd1306_i2c_dma_context
+{
+    i2c_inst_t *i2c;
+    uint8_t address;
+    /** DMA channel claimed by ssd1306_i2c_dma_context_init */
+    int dma_channel;
+    volatile bool busy;
+    SSD1306_Callback callback;
+    void *user_data;
+    /** I2C data commands fed to the TX FIFO, one per byte with the STOP flag on the last one */
+    uint16_t commands[SSD1306_MAX_FRAME_LENGTH];
+} SSD1306_I2C_DMA_Context;
+
+/**
+ * Context of the 4-wire SPI transport
+ */
+typedef struct ssd1306_spi_context
+{
+    spi_inst_t *spi;
+    /** Chip select pin, driven low during every frame */
+    uint8_t cs_pin;
+    /** Data/command pin, low for commands and high for GDDRAM data */
+    uint8_t dc_pin;
+} SSD1306_SPI_Context;
+
+/**
+ * I2C transport, the context must be a SSD1306_I2C_Context
+ */
+extern const SSD1306_Transport ssd1306_i2c_transport;
+
+/**
+ * I2C transport with asynchronous DMA writes, the context must be a SSD1306_I2C_DMA_Context
+ * initialized with ssd1306_i2c_dma_context_init
+ * @note Completion callbacks are called from the I2C interrupt handler
+ */
+extern const SSD1306_Transport ssd1306_i2c_dma_transport;
+
+/**
+ * Initializes a SSD1306_I2C_DMA_Context, claims a DMA channel and installs
+ * the DMA_IRQ_0 and I2C interrupt handlers
+ * @param c pointer to SSD1306_I2C_DMA_Context
+ * @param i2c I2C instance, initialized by the caller
+ * @param address SSD1306 I2C address
+ * @return false if there is no DMA channel available
+ * @note Only one context per I2C instance is supported
+ */
+bool ssd1306_i2c_dma_context_init(SSD1306_I2C_DMA_Context *c, i2c_inst_t *i2c, uint8_t address);
+
+/**
+ * 4-wire SPI transport, the context must be a SSD1306_SPI_Context
+ * @note The SPI instance and its pins must be configured by the caller
+ */
+extern const SSD1306_Transport ssd1306_spi_transport;
+
+/**
+ * Initializes the CS and DC pins of a SSD1306_SPI_Context as outputs
+ * @param s pointer to SSD1306_SPI_Context
+ */
+void ssd1306_spi_context_init(SSD1306_SPI_Context *s);
+
+/**
+ * Runs ssd1306_pipeline_run on core 1, so core 1 owns the transport of the pipeline
+ * while core 0 keeps drawing and calling ssd1306_pipeline_submit
+ * @param p pointer to SSD1306_Pipeline initialized with ssd1306_pipeline_init
+ */
+void ssd1306_pipeline_launch_core1(SSD1306_Pipeline *p);
+
+/**
+ * Set the display to a resolution of 128x64 dots in normal mode
+ * and horizontal addressing mode using SSD1306_I2C and SSD1306_ADDRESS
+ * @return a pointer to SSD1306_Display
+ */
+SSD1306_Display *ssd1306_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
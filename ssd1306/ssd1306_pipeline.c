@@ -0,0 +1,129 @@
+#ifdef SSD1306_HOST
+#define _POSIX_C_SOURCE 199309L
+#include <sched.h>
+#endif
+#include "ssd1306_pipeline.h"
+#include <string.h>
+#ifndef SSD1306_HOST
+#include "hardware/sync.h"
+#endif
+
+/**
+ * Idles the calling core until the other side of the queue may have made progress:
+ * on the Pico the core sleeps until an event is signalled, on the host the thread yields
+ */
+#ifdef SSD1306_HOST
+#define SSD1306_PIPELINE_WAIT() sched_yield()
+#define SSD1306_PIPELINE_SIGNAL() ((void)0)
+#else
+#define SSD1306_PIPELINE_WAIT() __wfe()
+#define SSD1306_PIPELINE_SIGNAL() __sev()
+#endif
+
+void ssd1306_pipeline_init(SSD1306_Pipeline *p, SSD1306_Display *d, uint8_t policy)
+{
+    p->renderer = d;
+    p->policy = policy;
+    p->head = 0;
+    p->tail = 0;
+    p->running = true;
+    p->submitted = 0;
+    p->dropped = 0;
+    p->presented = 0;
+
+    memcpy(p->mirror, d->frame, d->frame_length);
+    p->presenter = *d;
+    p->presenter.frame = p->mirror;
+    p->presenter.front = NULL;
+    /* The consumer takes over the shadow together with the duty to free it */
+    p->presenter.owned_buffers = d->owned_buffers & SSD1306_OWNS_SHADOW;
+    d->owned_buffers &= ~SSD1306_OWNS_SHADOW;
+    d->shadow = NULL;
+    d->shadow_valid = false;
+    memset(d->dirty_start, SSD1306_CLEAN_PAGE, SSD1306_MAX_PAGES);
+    memset(d->dirty_end, 0, SSD1306_MAX_PAGES);
+}
+
+bool ssd1306_pipeline_submit(SSD1306_Pipeline *p)
+{
+    SSD1306_Display *d = p->renderer;
+    uint32_t head = p->head;
+    while (head - __atomic_load_n(&p->tail, __ATOMIC_ACQUIRE) == SSD1306_PIPELINE_SLOTS)
+    {
+        if (p->policy == SSD1306_PIPELINE_DROP)
+        {
+            p->dropped++;
+            return false;
+        }
+        SSD1306_PIPELINE_WAIT();
+    }
+
+    SSD1306_Pipeline_Slot *slot = &p->slots[head & (SSD1306_PIPELINE_SLOTS - 1)];
+    for (uint8_t page = 0; page < SSD1306_PAGES(d); page++)
+    {
+        slot->dirty_start[page] = d->dirty_start[page];
+        slot->dirty_end[page] = d->dirty_end[page];
+        if (d->dirty_start[page] != SSD1306_CLEAN_PAGE)
+        {
+            uint32_t index = 1 + page * SSD1306_WIDTH(d) + d->dirty_start[page];
+            memcpy(slot->frame + index, d->frame + index, d->dirty_end[page] - d->dirty_start[page] + 1);
+        }
+        d->dirty_start[page] = SSD1306_CLEAN_PAGE;
+        d->dirty_end[page] = 0;
+    }
+    __atomic_store_n(&p->head, head + 1, __ATOMIC_RELEASE);
+    SSD1306_PIPELINE_SIGNAL();
+    p->submitted++;
+    return true;
+}
+
+bool ssd1306_pipeline_service(SSD1306_Pipeline *p)
+{
+    SSD1306_Display *d = &p->presenter;
+    uint32_t tail = p->tail;
+    uint32_t head = __atomic_load_n(&p->head, __ATOMIC_ACQUIRE);
+    if (tail == head)
+        return false;
+    while (tail != head)
+    {
+        const SSD1306_Pipeline_Slot *slot = &p->slots[tail & (SSD1306_PIPELINE_SLOTS - 1)];
+        for (uint8_t page = 0; page < SSD1306_PAGES(d); page++)
+        {
+            if (slot->dirty_start[page] != SSD1306_CLEAN_PAGE)
+            {
+                uint32_t index = 1 + page * SSD1306_WIDTH(d) + slot->dirty_start[page];
+                memcpy(d->frame + index, slot->frame + index, slot->dirty_end[page] - slot->dirty_start[page] + 1);
+                ssd1306_mark_dirty(d, page, slot->dirty_start[page], slot->dirty_end[page]);
+            }
+        }
+        tail++;
+        __atomic_store_n(&p->tail, tail, __ATOMIC_RELEASE);
+        SSD1306_PIPELINE_SIGNAL();
+    }
+    ssd1306_update_graphics(d);
+    p->presented++;
+    return true;
+}
+
+void ssd1306_pipeline_run(SSD1306_Pipeline *p)
+{
+    while (__atomic_load_n(&p->running, __ATOMIC_ACQUIRE))
+    {
+        if (!ssd1306_pipeline_service(p))
+            SSD1306_PIPELINE_WAIT();
+    }
+    ssd1306_pipeline_service(p);
+}
+
+void ssd1306_pipeline_stop(SSD1306_Pipeline *p)
+{
+    __atomic_store_n(&p->running, false, __ATOMIC_RELEASE);
+    SSD1306_PIPELINE_SIGNAL();
+}
+
+void ssd1306_pipeline_destroy(SSD1306_Pipeline *p)
+{
+    ssd1306_destroy_display(&p->presenter);
+    p->presenter.shadow = NULL;
+    p->presenter.owned_buffers = 0;
+}
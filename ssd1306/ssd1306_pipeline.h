@@ -0,0 +1,115 @@
+/**
+ * @file ssd1306_pipeline.h
+ * @brief Render/present pipeline: a lock-free single-producer/single-consumer queue of frame
+ * deltas between the core that draws and the core that owns the transport
+ * @author Iván Santiago
+ * @date 2023-08-10 19:32
+ */
+#ifndef SSD1306_PIPELINE_H_
+#define SSD1306_PIPELINE_H_
+
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of frame slots of the queue, must be a power of two
+ */
+#ifndef SSD1306_PIPELINE_SLOTS
+#define SSD1306_PIPELINE_SLOTS 4
+#endif
+/**
+ * Back-pressure policy: ssd1306_pipeline_submit waits for a free slot
+ */
+#define SSD1306_PIPELINE_BLOCK 0
+/**
+ * Frame-drop policy: ssd1306_pipeline_submit returns immediately when the queue is full,
+ * the changes of the dropped frame are carried by the next submitted one
+ */
+#define SSD1306_PIPELINE_DROP 1
+
+/**
+ * Frame delta: the dirty spans of a frame and their content
+ */
+typedef struct ssd1306_pipeline_slot
+{
+    uint8_t dirty_start[SSD1306_MAX_PAGES];
+    uint8_t dirty_end[SSD1306_MAX_PAGES];
+    /** Only the dirty spans are valid */
+    uint8_t frame[SSD1306_MAX_FRAME_LENGTH];
+} SSD1306_Pipeline_Slot;
+
+typedef struct ssd1306_pipeline
+{
+    /** Display the producer draws on, it is never written on the transport directly */
+    SSD1306_Display *renderer;
+    /** Display owned by the consumer: mirror of the GDDRAM content and the transport */
+    SSD1306_Display presenter;
+    uint8_t policy;
+    /** Slots produced, only written by the producer */
+    volatile uint32_t head;
+    /** Slots consumed, only written by the consumer */
+    volatile uint32_t tail;
+    volatile bool running;
+    /** Frames queued by the producer */
+    uint32_t submitted;
+    /** Frames dropped by the producer because the queue was full */
+    uint32_t dropped;
+    /** Updates written by the consumer, queued frames are coalesced into one update */
+    uint32_t presented;
+    uint8_t mirror[SSD1306_MAX_FRAME_LENGTH];
+    SSD1306_Pipeline_Slot slots[SSD1306_PIPELINE_SLOTS];
+} SSD1306_Pipeline;
+
+/**
+ * Initializes a SSD1306_Pipeline over a display. The consumer takes over the transport
+ * and the diff encoder shadow of the display, freed by ssd1306_pipeline_destroy; afterwards
+ * the display is only drawn on and its frames are presented through ssd1306_pipeline_submit
+ * @param p pointer to SSD1306_Pipeline
+ * @param d pointer to SSD1306_Display, no asynchronous update may be in progress
+ * @param policy SSD1306_PIPELINE_BLOCK or SSD1306_PIPELINE_DROP
+ */
+void ssd1306_pipeline_init(SSD1306_Pipeline *p, SSD1306_Display *d, uint8_t policy);
+
+/**
+ * Producer side: queues the dirty regions of the renderer frame and marks it clean
+ * @param p pointer to SSD1306_Pipeline
+ * @return false if the frame was dropped (SSD1306_PIPELINE_DROP and the queue is full)
+ */
+bool ssd1306_pipeline_submit(SSD1306_Pipeline *p);
+
+/**
+ * Consumer side: applies every queued frame delta to the mirror and writes the
+ * result with a single ssd1306_update_graphics
+ * @param p pointer to SSD1306_Pipeline
+ * @return false if the queue was empty
+ */
+bool ssd1306_pipeline_service(SSD1306_Pipeline *p);
+
+/**
+ * Consumer side: services the queue until ssd1306_pipeline_stop is called, then
+ * presents the frames still queued. While the queue is empty the core waits for an event
+ * (__wfe, woken by the __sev of ssd1306_pipeline_submit) or, on the host, yields
+ * @param p pointer to SSD1306_Pipeline
+ */
+void ssd1306_pipeline_run(SSD1306_Pipeline *p);
+
+/**
+ * Asks ssd1306_pipeline_run to return
+ * @param p pointer to SSD1306_Pipeline
+ */
+void ssd1306_pipeline_stop(SSD1306_Pipeline *p);
+
+/**
+ * Frees the diff encoder shadow taken over by the consumer. The pipeline must be stopped,
+ * the display given to ssd1306_pipeline_init is still destroyed by the caller
+ * @param p pointer to SSD1306_Pipeline
+ */
+void ssd1306_pipeline_destroy(SSD1306_Pipeline *p);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
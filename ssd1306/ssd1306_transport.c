@@ -0,0 +1,97 @@
+#include "ssd1306_transport.h"
+#include <stddef.h>
+#include <string.h>
+
+static void ssd1306_memory_write(void *context, const uint8_t *data, uint32_t length)
+{
+    SSD1306_Memory_Context *m = context;
+    if (m->buffer != NULL && m->length < m->capacity)
+    {
+        uint32_t n = m->capacity - m->length;
+        if (n > length)
+            n = length;
+        memcpy(m->buffer + m->length, data, n);
+        m->length += n;
+    }
+    m->bytes += length;
+    m->transactions++;
+}
+
+static void ssd1306_memory_complete(SSD1306_Memory_Context *m)
+{
+    m->pending = false;
+    m->pending_us = 0;
+    if (m->pending_callback != NULL)
+        m->pending_callback(m->pending_user_data);
+}
+
+static void ssd1306_memory_flush(void *context)
+{
+    SSD1306_Memory_Context *m = context;
+    if (m->pending)
+        ssd1306_memory_complete(m);
+}
+
+static void ssd1306_memory_write_blocking(void *context, const uint8_t *data, uint32_t length)
+{
+    ssd1306_memory_flush(context);
+    ssd1306_memory_write(context, data, length);
+}
+
+static bool ssd1306_memory_submit_async(void *context, const uint8_t *data, uint32_t length, SSD1306_Callback callback, void *user_data)
+{
+    SSD1306_Memory_Context *m = context;
+    ssd1306_memory_flush(m);
+    ssd1306_memory_write(m, data, length);
+    m->pending = true;
+    m->pending_callback = callback;
+    m->pending_user_data = user_data;
+    if (m->clock_hz == 0)
+    {
+        ssd1306_memory_complete(m);
+    }
+    else
+    {
+        /* Address byte plus every data byte take 9 clocks, start and stop about one each */
+        uint64_t clocks = (uint64_t)(length + 1) * 9 + 2;
+        m->pending_us = (uint32_t)((clocks * 1000000u + m->clock_hz - 1) / m->clock_hz);
+    }
+    return true;
+}
+
+const SSD1306_Transport ssd1306_memory_transport = {
+    .write_commands = ssd1306_memory_write_blocking,
+    .write_data = ssd1306_memory_write_blocking,
+    .submit_async = ssd1306_memory_submit_async,
+    .flush = ssd1306_memory_flush};
+
+void ssd1306_memory_context_init(SSD1306_Memory_Context *m, uint8_t *buffer, uint32_t capacity)
+{
+    m->buffer = buffer;
+    m->capacity = capacity;
+    m->clock_hz = 0;
+    m->pending = false;
+    m->pending_us = 0;
+    m->pending_callback = NULL;
+    m->pending_user_data = NULL;
+    ssd1306_memory_context_reset(m);
+}
+
+void ssd1306_memory_context_advance(SSD1306_Memory_Context *m, uint32_t elapsed_us)
+{
+    /* The callback may queue the next transfer, which gets the remaining time */
+    while (m->pending && elapsed_us >= m->pending_us)
+    {
+        elapsed_us -= m->pending_us;
+        ssd1306_memory_complete(m);
+    }
+    if (m->pending)
+        m->pending_us -= elapsed_us;
+}
+
+void ssd1306_memory_context_reset(SSD1306_Memory_Context *m)
+{
+    m->length = 0;
+    m->bytes = 0;
+    m->transactions = 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file ssd1306_transport.h
+ * @brief Transport interface used by the ssd1306 library to reach the controller
+ * @author Iván Santiago
+ * @date 2023-08-06 18:12
+ */
+#ifndef SSD1306_TRANSPORT_H_
+#define SSD1306_TRANSPORT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Function called by a transport when an asynchronous transfer has finished
+ * @param user_data pointer given when the transfer was submitted
+ */
+typedef void (*SSD1306_Callback)(void *user_data);
+
+/**
+ * Set of functions that move bytes from the library to a SSD1306 controller.
+ * Every buffer given to a transport reserves its first byte for the control byte
+ * (SSD1306_CONTROL_BYTE_COMMAND or SSD1306_CONTROL_BYTE_DATA) and length counts it,
+ * so I2C transports can send the buffer as is and SPI transports skip it.
+ */
+typedef struct ssd1306_transport
+{
+    /**
+     * Writes a command frame, returns when the buffer can be reused
+     * @param context transport context given to the display
+     * @param commands control byte followed by the command bytes
+     * @param length number of bytes of commands
+     */
+    void (*write_commands)(void *context, const uint8_t *commands, uint32_t length);
+    /**
+     * Writes a GDDRAM data frame, returns when the buffer can be reused
+     * @param context transport context given to the display
+     * @param data control byte followed by the GDDRAM bytes
+     * @param length number of bytes of data
+     */
+    void (*write_data)(void *context, const uint8_t *data, uint32_t length);
+    /**
+     * Starts a command or GDDRAM data frame and returns immediately, optional (NULL if not supported)
+     * @param context transport context given to the display
+     * @param data control byte followed by the command or GDDRAM bytes
+     * @param length number of bytes of data
+     * @param callback function called when the transfer finishes, may be NULL
+     * @param user_data pointer passed to callback
+     * @return false if the transfer could not be started
+     * @note data[0] is only read during the call, the rest of the buffer must not be
+     * modified until callback is called
+     */
+    bool (*submit_async)(void *context, const uint8_t *data, uint32_t length, SSD1306_Callback callback, void *user_data);
+    /**
+     * Blocks until every submitted transfer has finished
+     * @param context transport context given to the display
+     */
+    void (*flush)(void *context);
+} SSD1306_Transport;
+
+/**
+ * Context of the in-memory transport: keeps the bytes as they would appear on an I2C bus
+ */
+typedef struct ssd1306_memory_context
+{
+    /** Destination of the written bytes, may be NULL to only count them */
+    uint8_t *buffer;
+    /** Size of buffer */
+    uint32_t capacity;
+    /** Bytes stored in buffer */
+    uint32_t length;
+    /** Bytes written, including the ones that did not fit in buffer */
+    uint32_t bytes;
+    /** Number of command and data frames written */
+    uint32_t transactions;
+    /** Simulated I2C clock in Hz used to time asynchronous transfers, 0 completes them on submit */
+    uint32_t clock_hz;
+    /** Simulated time left until the pending asynchronous transfer finishes */
+    uint32_t pending_us;
+    SSD1306_Callback pending_callback;
+    void *pending_user_data;
+    bool pending;
+} SSD1306_Memory_Context;
+
+/**
+ * In-memory transport, the context must be a SSD1306_Memory_Context
+ */
+extern const SSD1306_Transport ssd1306_memory_transport;
+
+/**
+ * Initializes a SSD1306_Memory_Context
+ * @param m pointer to SSD1306_Memory_Context
+ * @param buffer destination of the written bytes, may be NULL
+ * @param capacity size of buffer
+ */
+void ssd1306_memory_context_init(SSD1306_Memory_Context *m, uint8_t *buffer, uint32_t capacity);
+
+/**
+ * Advances the simulated clock of a SSD1306_Memory_Context, completing the pending
+ * asynchronous transfers whose bus time has elapsed
+ * @param m pointer to SSD1306_Memory_Context
+ * @param elapsed_us simulated microseconds
+ */
+void ssd1306_memory_context_advance(SSD1306_Memory_Context *m, uint32_t elapsed_us);
+
+/**
+ * Discards the bytes stored in a SSD1306_Memory_Context and resets its counters
+ * @param m pointer to SSD1306_Memory_Context
+ */
+void ssd1306_memory_context_reset(SSD1306_Memory_Context *m);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,327 @@
+/**
+ * Microbenchmarks of the drawing, text and update primitives.
+ * Every result is printed as one JSON object per line.
+ */
+#ifdef SSD1306_HOST
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#else
+#include "pico/stdlib.h"
+#endif
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_font7seg.h"
+#include "ssd1306_font5x7.h"
+#include "ssd1306_font7x9.h"
+#include "ssd1306_font7x11.h"
+
+#ifdef SSD1306_HOST
+/** Repetitions of every workload */
+#define REPEAT 2000
+#else
+#define REPEAT 20
+#endif
+/** I2C clock used to estimate the bus time of the updates */
+#define I2C_CLOCK 400000u
+
+static SSD1306_Memory_Context bus;
+static SSD1306_Display *display;
+
+static uint64_t now_ns(void)
+{
+#ifdef SSD1306_HOST
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+#else
+    return time_us_64() * 1000u;
+#endif
+}
+
+/**
+ * Prints a result
+ * @param name benchmark name
+ * @param ops operations measured
+ * @param ns elapsed nanoseconds
+ * @param unit name of the work unit, NULL if the operation is the unit
+ * @param units work units done
+ */
+static void report(const char *name, uint32_t ops, uint64_t ns, const char *unit, uint64_t units)
+{
+    printf("{\"benchmark\": \"%s\", \"ops\": %u, \"ns_per_op\": %.1f", name, ops, (double)ns / ops);
+    if (unit != NULL)
+        printf(", \"%s_per_s\": %.0f", unit, units * 1e9 / (double)ns);
+    printf("}\n");
+}
+
+/**
+ * Prints the bus usage of the updates recorded in bus
+ * @param name benchmark name
+ * @param frames updates measured
+ * @param ns elapsed nanoseconds
+ */
+static void report_bus(const char *name, uint32_t frames, uint64_t ns)
+{
+    uint64_t clocks = (uint64_t)(bus.bytes + bus.transactions) * 9 + 2 * bus.transactions;
+    printf("{\"benchmark\": \"%s\", \"frames\": %u, \"ns_per_frame\": %.1f, \"bytes_per_frame\": %.1f, "
+           "\"transactions_per_frame\": %.1f, \"bus_us_per_frame\": %.1f}\n",
+           name, frames, (double)ns / frames, (double)bus.bytes / frames, (double)bus.transactions / frames,
+           clocks * 1e6 / I2C_CLOCK / frames);
+}
+
+static void benchmark_pixels(void)
+{
+    const uint32_t n = 128 * 64;
+    uint64_t elapsed = 0;
+    for (int r = 0; r < REPEAT; r++)
+    {
+        /* Every pixel set in the timed loop changes the frame and grows a dirty span */
+        memset(display->frame + 1, 0x00, display->frame_length - 1);
+        memset(display->dirty_start, SSD1306_CLEAN_PAGE, SSD1306_MAX_PAGES);
+        memset(display->dirty_end, 0, SSD1306_MAX_PAGES);
+        uint64_t start = now_ns();
+        for (uint8_t y = 0; y < 64; y++)
+            for (uint8_t x = 0; x < 128; x++)
+                ssd1306_put_pixel(display, x, y);
+        elapsed += now_ns() - start;
+    }
+    report("put_pixel", n * REPEAT, elapsed, "pixels", (uint64_t)n * REPEAT);
+}
+
+static void benchmark_lines(void)
+{
+    struct
+    {
+        const char *name;
+        int8_t x1, y1, x2, y2;
+        uint32_t pixels;
+    } lines[] = {
+        {"draw_line_horizontal", 0, 20, 127, 20, 128},
+        {"draw_line_vertical", 40, 0, 40, 63, 64},
+        {"draw_line_diagonal", 0, 0, 127, 63, 128},
+    };
+    for (unsigned i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+    {
+        uint64_t start = now_ns();
+        for (int r = 0; r < REPEAT * 10; r++)
+            ssd1306_draw_line(display, lines[i].x1, lines[i].y1, lines[i].x2, lines[i].y2);
+        report(lines[i].name, REPEAT * 10, now_ns() - start, "pixels", (uint64_t)lines[i].pixels * REPEAT * 10);
+    }
+}
+
+static void benchmark_shapes(void)
+{
+    uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_draw_circle(display, 64, 32, 20);
+    report("draw_circle_r20", REPEAT * 10, now_ns() - start, NULL, 0);
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_draw_ellipse(display, 64, 32, 60, 30);
+    report("draw_ellipse_60x30", REPEAT * 10, now_ns() - start, NULL, 0);
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_fill_circle(display, 64, 32, 20);
+    report("fill_circle_r20", REPEAT * 10, now_ns() - start, NULL, 0);
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_fill_triangle(display, 4, 60, 64, 2, 124, 44);
+    report("fill_triangle", REPEAT * 10, now_ns() - start, NULL, 0);
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_fill_rounded_rect(display, 4, 26, 120, 12, 5);
+    report("fill_rounded_rect_120x12", REPEAT * 10, now_ns() - start, NULL, 0);
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_clean(display);
+    report("clean", REPEAT * 10, now_ns() - start, NULL, 0);
+}
+
+static void benchmark_raster(void)
+{
+    uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+    {
+        ssd1306_fill_rect(display, 0, 0, 128, 64);
+        ssd1306_clean(display);
+    }
+    report("fill_clean_full", REPEAT * 10, now_ns() - start, "bytes", (uint64_t)2048 * REPEAT * 10);
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_invert_rect(display, 3, 5, 121, 50);
+    report("invert_rect_121x50", REPEAT * 10, now_ns() - start, NULL, 0);
+
+    start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_copy_rect(display, 0, 8, 128, 48, 0, 16 - (r & 1) * 16);
+    report("copy_rect_128x48", REPEAT * 10, now_ns() - start, NULL, 0);
+
+    static uint8_t sprite[16 * 2];
+    for (unsigned i = 0; i < sizeof(sprite); i++)
+        sprite[i] = (uint8_t)(0x5A ^ (i * 37));
+    SSD1306_Bitmap bitmap = {.data = sprite, .mask = NULL, .width = 16, .height = 16, .stride = 16};
+    start = now_ns();
+    for (int r = 0; r < REPEAT * 10; r++)
+        ssd1306_draw_bitmap(display, &bitmap, (int8_t)(r % 112), (int8_t)(r % 48), SSD1306_BLIT_XOR);
+    report("draw_bitmap_16x16", REPEAT * 10, now_ns() - start, "pixels", (uint64_t)256 * REPEAT * 10);
+    ssd1306_clean(display);
+}
+
+static void benchmark_text(void)
+{
+    struct
+    {
+        const char *name;
+        const SSD1306_Font *font;
+        const char *text;
+    } fonts[] = {
+        {"print_font5x7", &ssd1306_font5x7, "The quick brown fox jumps over the lazy dog 0123456789"},
+        {"print_font7x9", &ssd1306_font7x9, "The quick brown fox jumps over the lazy dog 0123456789"},
+        {"print_font7x11", &ssd1306_font7x11, "The quick brown fox jumps over the lazy dog 0123456789"},
+        {"print_font7segment", &ssd1306_font7segment, "12:34.5"},
+    };
+    for (unsigned i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++)
+    {
+        uint32_t glyphs = 0;
+        uint64_t elapsed = 0;
+        ssd1306_set_font(display, fonts[i].font);
+        for (int r = 0; r < REPEAT; r++)
+        {
+            ssd1306_set_cursor(display, 0, 0);
+            uint64_t start = now_ns();
+            ssd1306_print(display, fonts[i].text);
+            elapsed += now_ns() - start;
+            for (const char *c = fonts[i].text; *c; c++)
+                glyphs++;
+        }
+        report(fonts[i].name, REPEAT, elapsed, "glyphs", glyphs);
+    }
+
+    const char *alert = "Temperature high: check the cooling fan and the air filter\nPress OK to acknowledge";
+    ssd1306_set_font(display, &ssd1306_font5x7);
+    uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++)
+    {
+        int16_t width, height;
+        ssd1306_measure_text(display, alert, 120, &width, &height);
+        ssd1306_print_box(display, alert, 4, (64 - height) / 2, 120, height, SSD1306_TEXT_CENTER);
+    }
+    report("print_box_alert", REPEAT, now_ns() - start, NULL, 0);
+    ssd1306_clean(display);
+}
+
+static void benchmark_updates(void)
+{
+    ssd1306_update_graphics(display);
+    ssd1306_memory_context_reset(&bus);
+    uint64_t start = now_ns();
+    for (int r = 0; r < REPEAT; r++)
+    {
+        ssd1306_invalidate(display);
+        ssd1306_update_graphics(display);
+    }
+    report_bus("update_full", REPEAT, now_ns() - start);
+
+    ssd1306_clean(display);
+    ssd1306_set_font(display, &ssd1306_font7x11);
+    ssd1306_update_graphics(display);
+    ssd1306_memory_context_reset(&bus);
+    start = now_ns();
+    for (int r = 0; r < REPEAT; r++)
+    {
+        char label[4] = {'0' + r % 10, '0' + r / 10 % 10, '0' + r / 100 % 10, 0};
+        ssd1306_set_cursor(display, 100, 3);
+        ssd1306_print(display, label);
+        ssd1306_update_graphics(display);
+    }
+    report_bus("update_label", REPEAT, now_ns() - start);
+}
+
+static void draw_branch(SSD1306_Display *d, int16_t sx, int16_t sy, float len, float angle, float angle_increment)
+{
+    if (len >= 1.0f)
+    {
+        int16_t rx = sx + (int16_t)(roundf(len * sinf(angle)));
+        int16_t ry = sy - (int16_t)(roundf(len * cosf(angle)));
+        ssd1306_draw_line(d, sx, sy, rx, ry);
+        draw_branch(d, rx, ry, 0.7f * len, angle + angle_increment, angle_increment);
+        draw_branch(d, rx, ry, 0.7f * len, angle - angle_increment, angle_increment);
+    }
+}
+
+/**
+ * Replays the test/fractal_tree animation
+ * @param name benchmark name
+ */
+static void benchmark_fractal_tree(const char *name)
+{
+    float angle_increment = 0.0f;
+    uint64_t render = 0;
+    ssd1306_update_graphics(display);
+    ssd1306_memory_context_reset(&bus);
+    uint64_t start = now_ns();
+    for (int frame = 0; frame < REPEAT; frame++)
+    {
+        uint64_t t = now_ns();
+        ssd1306_clean(display);
+        ssd1306_draw_line(display, 64, 63, 64, 42);
+        draw_branch(display, 64, 42, 0.7f * 22.0f, angle_increment, angle_increment);
+        draw_branch(display, 64, 42, 0.7f * 22.0f, -angle_increment, -angle_increment);
+        render += now_ns() - t;
+        angle_increment += 0.02f;
+        if (angle_increment >= 6.28318530717959f)
+            angle_increment -= 6.28318530717959f;
+        ssd1306_update_graphics(display);
+    }
+    report_bus(name, REPEAT, now_ns() - start);
+    char render_name[32];
+    snprintf(render_name, sizeof(render_name), "%s_render", name);
+    report(render_name, REPEAT, render, NULL, 0);
+}
+
+int main(void)
+{
+#ifndef SSD1306_HOST
+    stdio_init_all();
+    sleep_ms(2000);
+#endif
+    ssd1306_memory_context_init(&bus, NULL, 0);
+    display = ssd1306_init_transport(&ssd1306_memory_transport, &bus);
+    if (display == NULL)
+    {
+        printf("ssd1306_init_transport failed: out of memory or no geometry matches this build\n");
+        return 1;
+    }
+
+    benchmark_pixels();
+    benchmark_lines();
+    benchmark_shapes();
+    benchmark_raster();
+    benchmark_text();
+    benchmark_updates();
+    benchmark_fractal_tree("fractal_tree");
+    ssd1306_enable_diff_encoding(display);
+#ifdef SSD1306_ENABLE_STATS
+    ssd1306_reset_stats(display);
+#endif
+    benchmark_fractal_tree("fractal_tree_diff");
+#ifdef SSD1306_ENABLE_STATS
+    SSD1306_Stats stats;
+    ssd1306_get_stats(display, &stats);
+    printf("{\"stats\": \"fractal_tree_diff\", \"frames\": %u, \"pixels\": %u, \"glyphs\": %u, \"bytes\": %u, "
+           "\"transactions\": %u, \"render_us\": %llu, \"transmit_us\": %llu}\n",
+           stats.frames, stats.pixels, stats.glyphs, stats.bytes, stats.transactions,
+           (unsigned long long)stats.render_us, (unsigned long long)stats.transmit_us);
+#endif
+
+    ssd1306_destroy_display(display);
+    return 0;
+}
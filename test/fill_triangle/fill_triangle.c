@@ -0,0 +1,113 @@
+/**
+ * Host check of ssd1306_fill_triangle: for random triangles, on screen and reaching far
+ * outside it, with and without a clip rectangle, the filled triangle must cover every pixel
+ * of the ssd1306_draw_triangle outline of the same vertices and fill each column without
+ * gaps. Returns nonzero on the first mismatch
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "ssd1306.h"
+
+#define TRIANGLES 20000
+
+static bool pixel(const SSD1306_Display *d, int32_t x, int32_t y)
+{
+    return d->frame[1 + x + (y >> 3) * SSD1306_WIDTH(d)] & (1u << (y & 7));
+}
+
+/**
+ * Compares the outline and the filled triangle of the same vertices
+ * @param outline display with the ssd1306_draw_triangle outline
+ * @param filled display with the ssd1306_fill_triangle triangle
+ * @param exact true if the outline is not clipped, every column is then filled exactly
+ * from its first to its last outline pixel
+ * @return false on a mismatch
+ */
+static bool check(const SSD1306_Display *outline, const SSD1306_Display *filled, bool exact)
+{
+    for (int32_t x = 0; x < SSD1306_WIDTH(filled); x++)
+    {
+        int32_t first = -1, last = -1, top = -1, bottom = -1, count = 0;
+        for (int32_t y = 0; y < SSD1306_HEIGHT(filled); y++)
+        {
+            if (pixel(outline, x, y))
+            {
+                if (!pixel(filled, x, y))
+                    return false;
+                if (first < 0)
+                    first = y;
+                last = y;
+            }
+            if (pixel(filled, x, y))
+            {
+                if (top < 0)
+                    top = y;
+                bottom = y;
+                count++;
+            }
+        }
+        if (count != 0 && count != bottom - top + 1)
+            return false;
+        if (exact && (top != first || bottom != last))
+            return false;
+    }
+    return true;
+}
+
+static int16_t random_coordinate(int32_t size, bool far)
+{
+    return far ? (int16_t)(rand() % (size * 6) - size * 3) : (int16_t)(rand() % size);
+}
+
+int main(void)
+{
+    static SSD1306_Memory_Context bus;
+    ssd1306_memory_context_init(&bus, NULL, 0);
+    SSD1306_Display *outline = ssd1306_init_transport(&ssd1306_memory_transport, &bus);
+    SSD1306_Display *filled = ssd1306_init_transport(&ssd1306_memory_transport, &bus);
+    if (outline == NULL || filled == NULL)
+    {
+        printf("ssd1306_init_transport failed: out of memory or no geometry matches this build\n");
+        return 1;
+    }
+
+    srand(15);
+    uint32_t failures = 0;
+    for (uint32_t i = 0; i < TRIANGLES; i++)
+    {
+        int16_t v[6] = {43, 14, 47, 26, 48, 55};
+        bool far = i % 4 == 3;
+        bool clipped = i % 3 == 2;
+        if (i != 0)
+        {
+            for (uint8_t k = 0; k < 6; k += 2)
+            {
+                v[k] = random_coordinate(SSD1306_WIDTH(filled), far);
+                v[k + 1] = random_coordinate(SSD1306_HEIGHT(filled), far);
+            }
+        }
+        ssd1306_reset_clip(outline);
+        ssd1306_reset_clip(filled);
+        if (clipped)
+        {
+            int16_t x = rand() % 100, y = rand() % 50, w = rand() % 100, h = rand() % 50;
+            ssd1306_set_clip(outline, x, y, w, h);
+            ssd1306_set_clip(filled, x, y, w, h);
+        }
+        ssd1306_clean(outline);
+        ssd1306_clean(filled);
+        ssd1306_draw_triangle(outline, v[0], v[1], v[2], v[3], v[4], v[5]);
+        ssd1306_fill_triangle(filled, v[0], v[1], v[2], v[3], v[4], v[5]);
+        if (!check(outline, filled, !far && !clipped))
+        {
+            if (failures == 0)
+                printf("triangle (%d,%d) (%d,%d) (%d,%d)%s: fill does not cover its outline\n", v[0], v[1], v[2], v[3], v[4], v[5],
+                       clipped ? " clipped" : "");
+            failures++;
+        }
+    }
+    printf("%u triangles, %u failed\n", TRIANGLES, failures);
+    ssd1306_destroy_display(outline);
+    ssd1306_destroy_display(filled);
+    return failures != 0;
+}
@@ -0,0 +1,11 @@
+# Runs COMPILER with ARGUMENTS and OUTPUT, then compares OUTPUT.c and OUTPUT.h with EXPECTED.c and EXPECTED.h
+execute_process(COMMAND ${COMPILER} ${ARGUMENTS} ${OUTPUT} RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "ssd1306_font_compiler ${ARGUMENTS} failed with ${result}")
+endif()
+foreach(extension .c .h)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${OUTPUT}${extension} ${EXPECTED}${extension} RESULT_VARIABLE different)
+    if (different)
+        message(FATAL_ERROR "${OUTPUT}${extension} differs from ${EXPECTED}${extension}")
+    endif()
+endforeach()
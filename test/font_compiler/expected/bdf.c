@@ -0,0 +1,45 @@
+#include "bdf.h"
+
+static const uint8_t font_bdf_array[64] = {
+    0x00, 0x00, 0x00, 0xbe, 0x04, 0x02, 0xa2, 0x12, 0x0c, 0xfc, 0x12, 0x12, 0x12, 0xfc, 0x00, 0x08,
+    0xfa, 0x10, 0x08, 0x18, 0x10, 0x08, 0x7c, 0x44, 0x44, 0x44, 0x7c, 0x78, 0x94, 0x96, 0x95, 0x98,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+static const uint32_t font_bdf_character_offset[97] = {
+    0, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 9, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 14, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 17, 22,
+    27};
+
+static const uint8_t font_bdf_character_width[97] = {
+    3, 1, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5};
+
+static const uint32_t font_bdf_vertical_offsets[1] = {
+    32u};
+
+static const uint16_t font_bdf_codepoints[2] = {
+    0x0001, 0x00e9};
+
+const SSD1306_Font ssd1306_font_bdf = {
+    .name = "bdf",
+    .first_character = 32,
+    .last_character = 126,
+    .overflow_character = 63,
+    .font_array = font_bdf_array,
+    .character_offset = font_bdf_character_offset,
+    .character_width = font_bdf_character_width,
+    .character_height = 2u,
+    .vertical_offsets = font_bdf_vertical_offsets,
+    .character_spacing = 1u,
+    .codepoints = font_bdf_codepoints,
+    .codepoint_count = 2u};
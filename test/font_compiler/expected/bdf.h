@@ -0,0 +1,18 @@
+#ifndef BDF_H_
+#define BDF_H_
+
+#include "ssd1306_font.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 16 pixels high font of 97 glyphs, generated by ssd1306_font_compiler from fixture.bdf
+ */
+extern const SSD1306_Font ssd1306_font_bdf;
+
+#ifdef __cplusplus
+}
+#endif
+#endif
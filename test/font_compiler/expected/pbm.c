@@ -0,0 +1,25 @@
+#include "pbm.h"
+
+static const uint8_t font_pbm_array[18] = {
+    0x0e, 0x11, 0x0e, 0x12, 0x1f, 0x10, 0x19, 0x15, 0x12, 0x11, 0x15, 0x0a, 0x07, 0x04, 0x1f, 0x17,
+    0x15, 0x09};
+
+static const uint32_t font_pbm_character_offset[6] = {
+    0, 3, 6, 9, 12, 15};
+
+static const uint8_t font_pbm_character_width[6] = {
+    3, 3, 3, 3, 3, 3};
+
+static const uint32_t font_pbm_vertical_offsets[1] = {0};
+
+const SSD1306_Font ssd1306_font_pbm = {
+    .name = "pbm",
+    .first_character = 48,
+    .last_character = 53,
+    .overflow_character = 48,
+    .font_array = font_pbm_array,
+    .character_offset = font_pbm_character_offset,
+    .character_width = font_pbm_character_width,
+    .character_height = 1u,
+    .vertical_offsets = font_pbm_vertical_offsets,
+    .character_spacing = 1u};
@@ -0,0 +1,18 @@
+#ifndef PBM_H_
+#define PBM_H_
+
+#include "ssd1306_font.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 8 pixels high font of 6 glyphs, generated by ssd1306_font_compiler from fixture.pbm
+ */
+extern const SSD1306_Font ssd1306_font_pbm;
+
+#ifdef __cplusplus
+}
+#endif
+#endif
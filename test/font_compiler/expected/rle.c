@@ -0,0 +1,41 @@
+#include "rle.h"
+
+static const uint8_t font_rle_array[46] = {
+    0x85, 0x01, 0xbe, 0x00, 0x04, 0x04, 0x02, 0xa2, 0x12, 0x0c, 0x84, 0x00, 0xfc, 0xc2, 0x12, 0x00,
+    0xfc, 0x84, 0x80, 0x04, 0x08, 0xfa, 0x01, 0x02, 0x01, 0x04, 0x10, 0x08, 0x18, 0x10, 0x08, 0x84,
+    0x00, 0x7c, 0xc2, 0x44, 0x00, 0x7c, 0x84, 0x04, 0x78, 0x94, 0x96, 0x95, 0x98, 0x84};
+
+static const uint32_t font_rle_character_offset[97] = {
+    0, 1, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 11, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 18, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 25, 32,
+    39};
+
+static const uint8_t font_rle_character_width[97] = {
+    3, 1, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5};
+
+static const uint16_t font_rle_codepoints[2] = {
+    0x0001, 0x00e9};
+
+const SSD1306_Font ssd1306_font_rle = {
+    .name = "rle",
+    .first_character = 32,
+    .last_character = 126,
+    .overflow_character = 63,
+    .font_array = font_rle_array,
+    .character_offset = font_rle_character_offset,
+    .character_width = font_rle_character_width,
+    .character_height = 2u,
+    .character_spacing = 1u,
+    .codepoints = font_rle_codepoints,
+    .codepoint_count = 2u,
+    .encoding = SSD1306_FONT_RLE};
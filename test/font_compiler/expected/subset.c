@@ -0,0 +1,35 @@
+#include "subset.h"
+
+static const uint8_t font_subset_array[32] = {
+    0xbe, 0x04, 0x02, 0xa2, 0x12, 0x0c, 0xfc, 0x12, 0x12, 0x12, 0xfc, 0x78, 0x94, 0x96, 0x95, 0x98,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+static const uint32_t font_subset_character_offset[34] = {
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    6, 11};
+
+static const uint8_t font_subset_character_width[34] = {
+    1, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5};
+
+static const uint32_t font_subset_vertical_offsets[1] = {
+    16u};
+
+static const uint16_t font_subset_codepoints[1] = {
+    0x00e9};
+
+const SSD1306_Font ssd1306_font_subset = {
+    .name = "subset",
+    .first_character = 33,
+    .last_character = 65,
+    .overflow_character = 63,
+    .font_array = font_subset_array,
+    .character_offset = font_subset_character_offset,
+    .character_width = font_subset_character_width,
+    .character_height = 2u,
+    .vertical_offsets = font_subset_vertical_offsets,
+    .character_spacing = 1u,
+    .codepoints = font_subset_codepoints,
+    .codepoint_count = 1u};
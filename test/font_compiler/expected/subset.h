@@ -0,0 +1,18 @@
+#ifndef SUBSET_H_
+#define SUBSET_H_
+
+#include "ssd1306_font.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 16 pixels high font of 34 glyphs, generated by ssd1306_font_compiler from fixture.bdf
+ */
+extern const SSD1306_Font ssd1306_font_subset;
+
+#ifdef __cplusplus
+}
+#endif
+#endif
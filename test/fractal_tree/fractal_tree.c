@@ -1,12 +1,23 @@
 #include <math.h>
+#ifdef SSD1306_HOST
+#include "ssd1306_emulator.h"
+#else
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "hardware/gpio.h"
-#include "ssd1306.h"
+#include "ssd1306_pico.h"
+#endif
 
 #define SDA_PIN 8 /** pico pin 11 */
 #define SCL_PIN 9 /** pico pin 12 */
 
+#ifdef SSD1306_HOST
+/** Frames rendered on the host */
+#define FRAMES 300
+static SSD1306_Emulator emulator;
+#define sleep_ms(ms)
+#endif
+
 void draw_branch(SSD1306_Display *d, int16_t sx, int16_t sy, float len, float angle, float angle_increment)
 {
     if (len >= 1.0f)
@@ -21,6 +32,18 @@ void draw_branch(SSD1306_Display *d, int16_t sx, int16_t sy, float len, float an
 
 int main(void)
 {
+#ifdef SSD1306_HOST
+    ssd1306_emulator_init(&emulator, 400000u);
+    SSD1306_Display *display = ssd1306_init_transport(&ssd1306_emulator_transport, &emulator);
+    if (display == NULL)
+    {
+        printf("ssd1306_init_transport failed: out of memory or no geometry matches this build\n");
+        return 1;
+    }
+    uint32_t frames = 0;
+    /* Frames whose GDDRAM content did not match the frame after the update */
+    uint32_t mismatches = 0;
+#else
     i2c_init(SSD1306_I2C, 400000u);
     gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
     gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);
@@ -28,6 +51,7 @@ int main(void)
     gpio_pull_up(SCL_PIN);
 
     SSD1306_Display *display = ssd1306_init();
+#endif
 
     uint8_t sx = 64;
     uint8_t sy = 42;
@@ -46,7 +70,23 @@ int main(void)
         if (angle_increment >= 6.28318530717959f) angle_increment -= 6.28318530717959f;
         ssd1306_update_graphics(display);
         sleep_ms(10);
+#ifdef SSD1306_HOST
+        if (ssd1306_emulator_compare(&emulator, display->frame, SSD1306_WIDTH(display), SSD1306_PAGES(display), display->column_offset) != 0)
+            mismatches++;
+        if (++frames == FRAMES)
+            break;
+#endif
     }
+#ifdef SSD1306_HOST
+    ssd1306_emulator_print(&emulator, stdout, 128, 64);
+    printf("%u frames, %u transactions, %u data bytes, %llu us on the bus\n", frames, emulator.transactions,
+           emulator.data_bytes, (unsigned long long)ssd1306_emulator_bus_us(&emulator));
+    if (mismatches != 0 || emulator.errors != 0)
+        fprintf(stderr, "%u frames not presented, %u bus errors\n", mismatches, emulator.errors);
+    ssd1306_destroy_display(display);
+    return mismatches != 0 || emulator.errors != 0;
+#else
     ssd1306_destroy_display(display);
     return 0;
+#endif
 }
\ No newline at end of file
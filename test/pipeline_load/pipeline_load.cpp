@@ -0,0 +1,87 @@
+/**
+ * Host load test of the render/present pipeline: one std::thread renders and submits
+ * frames while another owns a transport that simulates the I2C bus time. Fails if the
+ * last rendered frame is not the content of the emulated GDDRAM once the pipeline stops
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "ssd1306.h"
+#include "ssd1306_emulator.h"
+#include "ssd1306_pipeline.h"
+
+#define I2C_CLOCK 400000u
+#define FRAMES 600
+
+static SSD1306_Emulator emulator;
+
+/**
+ * Decodes the bytes and sleeps for the time they would take on the I2C bus
+ */
+static void bus_write(void *context, const uint8_t *data, uint32_t length)
+{
+    ssd1306_emulator_write((SSD1306_Emulator *)context, data, length);
+    uint64_t clocks = (uint64_t)(length + 1) * 9 + 2;
+    std::this_thread::sleep_for(std::chrono::microseconds(clocks * 1000000u / I2C_CLOCK));
+}
+
+static void bus_flush(void *context)
+{
+    (void)context;
+}
+
+static const SSD1306_Transport bus_transport = {bus_write, bus_write, NULL, bus_flush};
+
+int main(int argc, char **argv)
+{
+    uint8_t policy = argc > 1 ? (uint8_t)atoi(argv[1]) : SSD1306_PIPELINE_DROP;
+    ssd1306_emulator_init(&emulator, I2C_CLOCK);
+    SSD1306_Display *display = ssd1306_init_transport(&bus_transport, &emulator);
+    if (display == NULL)
+    {
+        printf("ssd1306_init_transport failed: out of memory or no geometry matches this build\n");
+        return 1;
+    }
+    ssd1306_enable_diff_encoding(display);
+
+    static SSD1306_Pipeline pipeline;
+    ssd1306_pipeline_init(&pipeline, display, policy);
+    std::thread presenter(ssd1306_pipeline_run, &pipeline);
+
+    auto start = std::chrono::steady_clock::now();
+    bool queued = true;
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        ssd1306_clean(display);
+        ssd1306_draw_circle(display, frame % 128, 32, 12);
+        ssd1306_draw_line(display, 0, frame % 64, 127, 63 - frame % 64);
+        queued = ssd1306_pipeline_submit(&pipeline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    /* The changes of a dropped last frame only reach the display with a later submit */
+    while (!queued)
+    {
+        std::this_thread::yield();
+        queued = ssd1306_pipeline_submit(&pipeline);
+    }
+    auto rendered = std::chrono::steady_clock::now();
+    ssd1306_pipeline_stop(&pipeline);
+    presenter.join();
+    auto end = std::chrono::steady_clock::now();
+
+    double render_s = std::chrono::duration<double>(rendered - start).count();
+    double total_s = std::chrono::duration<double>(end - start).count();
+    printf("{\"policy\": %u, \"frames\": %d, \"submitted\": %u, \"dropped\": %u, \"presented\": %u, "
+           "\"bytes\": %u, \"render_fps\": %.1f, \"present_fps\": %.1f}\n",
+           policy, FRAMES, pipeline.submitted, pipeline.dropped, pipeline.presented,
+           emulator.command_bytes + emulator.data_bytes, FRAMES / render_s, pipeline.presented / total_s);
+
+    uint32_t differences = ssd1306_emulator_compare(&emulator, display->frame, SSD1306_WIDTH(display), SSD1306_PAGES(display), display->column_offset);
+    if (differences != 0 || emulator.errors != 0)
+        fprintf(stderr, "last frame not presented: %u GDDRAM bytes differ, %u bus errors\n", differences, emulator.errors);
+    ssd1306_pipeline_destroy(&pipeline);
+    ssd1306_destroy_display(display);
+    return differences != 0 || emulator.errors != 0;
+}
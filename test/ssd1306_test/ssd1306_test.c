@@ -1,8 +1,11 @@
+#ifdef SSD1306_HOST
+#include "ssd1306_emulator.h"
+#else
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "hardware/gpio.h"
-#include "ssd1306.h"
-#include "ssd1306_font7seg.h"
+#include "ssd1306_pico.h"
+#endif
 #include "ssd1306_font5x7.h"
 #include "ssd1306_font7x9.h"
 #include "ssd1306_font7x11.h"
@@ -11,8 +14,42 @@
 #define SCL_PIN 9 /** pico pin 12 */
 #define DELAY 1000
 
+#ifdef SSD1306_HOST
+static SSD1306_Emulator emulator;
+/** Screens whose GDDRAM content did not match the frame */
+static uint32_t mismatches;
+
+/**
+ * Prints the screen and checks that the emulated GDDRAM holds the frame
+ * @param d pointer to SSD1306_Display
+ */
+static void show_screen(const SSD1306_Display *d)
+{
+    ssd1306_emulator_print(&emulator, stdout, 128, 64);
+    putchar('\n');
+    uint32_t differences = ssd1306_emulator_compare(&emulator, d->frame, SSD1306_WIDTH(d), SSD1306_PAGES(d), d->column_offset);
+    if (differences != 0 || emulator.errors != 0)
+    {
+        fprintf(stderr, "screen not presented: %u GDDRAM bytes differ, %u bus errors\n", differences, emulator.errors);
+        mismatches++;
+    }
+}
+
+/** On the host every screen is printed and checked instead of waiting */
+#define sleep_ms(ms) show_screen(display)
+#endif
+
 int main(void)
 {
+#ifdef SSD1306_HOST
+    ssd1306_emulator_init(&emulator, 400000u);
+    SSD1306_Display *display = ssd1306_init_transport(&ssd1306_emulator_transport, &emulator);
+    if (display == NULL)
+    {
+        printf("ssd1306_init_transport failed: out of memory or no geometry matches this build\n");
+        return 1;
+    }
+#else
     i2c_init(SSD1306_I2C, 400000u);
     gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
     gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);
@@ -20,6 +57,7 @@ int main(void)
     gpio_pull_up(SCL_PIN);
 
     SSD1306_Display *display = ssd1306_init();
+#endif
 
     char str[97];
     for (int i = 0; i < 96; i++)
@@ -88,11 +126,18 @@ int main(void)
         sleep_ms(DELAY);
 
         ssd1306_clean(display);
-        ssd1306_set_font(display, &ssd1306_font7segment);
+        ssd1306_set_font(display, ssd1306_find_font("7segment"));
         ssd1306_print(display, "0:123456789.");
         ssd1306_update_graphics(display);
         sleep_ms(DELAY);
+#ifdef SSD1306_HOST
+        break;
+#endif
     }
     ssd1306_destroy_display(display);
+#ifdef SSD1306_HOST
+    return mismatches != 0;
+#else
     return 0;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,221 @@
+/**
+ * Host check of the update paths: random frames are drawn and presented through every
+ * combination of synchronous and asynchronous updates, double buffering and diff encoding,
+ * on panels of several geometries, and after every update the GDDRAM decoded by the
+ * emulator must hold the presented frame, and the asynchronous paths must send the bytes of
+ * the synchronous ones. Returns nonzero on the first mismatch
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_emulator.h"
+#include "ssd1306_font5x7.h"
+
+#define FRAMES 200
+/** Simulated I2C clock, asynchronous transfers stay pending for their bus time */
+#define I2C_CLOCK 400000u
+
+#define PATH_ASYNC 0x01
+#define PATH_DOUBLE_BUFFER 0x02
+#define PATH_DIFF 0x04
+
+/**
+ * Memory transport whose transactions are also decoded by an emulator. An asynchronous
+ * transfer is decoded when it completes, so a frame modified while it is pending shows up
+ * as a GDDRAM mismatch; only its first byte is taken on submit, as the transport contract allows
+ */
+typedef struct checked_bus
+{
+    SSD1306_Memory_Context memory;
+    SSD1306_Emulator emulator;
+    const uint8_t *pending;
+    uint32_t pending_length;
+    uint8_t pending_control;
+    SSD1306_Callback callback;
+    void *user_data;
+} Checked_Bus;
+
+static void bus_write(void *context, const uint8_t *data, uint32_t length)
+{
+    Checked_Bus *b = context;
+    ssd1306_memory_transport.write_data(&b->memory, data, length);
+    ssd1306_emulator_write(&b->emulator, data, length);
+}
+
+static void bus_complete(void *user_data)
+{
+    static uint8_t transaction[SSD1306_MAX_FRAME_LENGTH];
+    Checked_Bus *b = user_data;
+    transaction[0] = b->pending_control;
+    memcpy(transaction + 1, b->pending + 1, b->pending_length - 1);
+    ssd1306_emulator_write(&b->emulator, transaction, b->pending_length);
+    b->pending = NULL;
+    if (b->callback != NULL)
+        b->callback(b->user_data);
+}
+
+static bool bus_submit_async(void *context, const uint8_t *data, uint32_t length, SSD1306_Callback callback, void *user_data)
+{
+    Checked_Bus *b = context;
+    b->pending = data;
+    b->pending_length = length;
+    b->pending_control = data[0];
+    b->callback = callback;
+    b->user_data = user_data;
+    return ssd1306_memory_transport.submit_async(&b->memory, data, length, bus_complete, b);
+}
+
+static void bus_flush(void *context)
+{
+    Checked_Bus *b = context;
+    ssd1306_memory_transport.flush(&b->memory);
+}
+
+static const SSD1306_Transport checked_transport = {bus_write, bus_write, bus_submit_async, bus_flush};
+
+static int16_t random_coordinate(int16_t size)
+{
+    return (int16_t)(rand() % (size + 16)) - 8;
+}
+
+/**
+ * Draws a few random primitives over the frame
+ * @param d pointer to SSD1306_Display
+ */
+static void draw_random(SSD1306_Display *d)
+{
+    int16_t w = SSD1306_WIDTH(d), h = SSD1306_HEIGHT(d);
+    if (rand() % 8 == 0)
+        ssd1306_clean(d);
+    for (int i = rand() % 4; i >= 0; i--)
+    {
+        ssd1306_set_draw_mode(d, rand() % 3);
+        switch (rand() % 6)
+        {
+        case 0:
+            ssd1306_put_pixel(d, random_coordinate(w), random_coordinate(h));
+            break;
+        case 1:
+            ssd1306_draw_line(d, random_coordinate(w), random_coordinate(h), random_coordinate(w), random_coordinate(h));
+            break;
+        case 2:
+            ssd1306_fill_rect(d, random_coordinate(w), random_coordinate(h), rand() % 40, rand() % 24);
+            break;
+        case 3:
+            ssd1306_invert_rect(d, random_coordinate(w), random_coordinate(h), rand() % 40, rand() % 24);
+            break;
+        case 4:
+            ssd1306_fill_circle(d, random_coordinate(w), random_coordinate(h), rand() % 12);
+            break;
+        default:
+            ssd1306_set_cursor_xy(d, random_coordinate(w), random_coordinate(h));
+            ssd1306_print(d, "Update 42");
+            break;
+        }
+    }
+    ssd1306_set_draw_mode(d, SSD1306_DRAW_SET);
+}
+
+/**
+ * Presents random frames through one update path. Every path draws the same frames, so
+ * the asynchronous paths must hand the transport the same bytes as the synchronous ones
+ * @param bytes set to the bytes handed to the transport
+ * @return number of updates after which the GDDRAM did not hold the presented frame
+ */
+static uint32_t check_path(const SSD1306_Geometry *g, const char *name, uint8_t path, uint32_t *bytes)
+{
+    static Checked_Bus bus;
+    static uint8_t expected[SSD1306_MAX_FRAME_LENGTH];
+    ssd1306_memory_context_init(&bus.memory, NULL, 0);
+    bus.memory.clock_hz = I2C_CLOCK;
+    bus.pending = NULL;
+    ssd1306_emulator_init(&bus.emulator, I2C_CLOCK);
+    *bytes = 0;
+
+    SSD1306_Display *d = ssd1306_init_geometry(g, &checked_transport, &bus);
+    if (d == NULL)
+    {
+        printf("%ux%u %s: skipped, geometry not supported by this build\n", g->width, g->height, name);
+        return 0;
+    }
+    if (((path & PATH_DOUBLE_BUFFER) && !ssd1306_enable_double_buffer(d)) || ((path & PATH_DIFF) && !ssd1306_enable_diff_encoding(d)))
+    {
+        printf("%ux%u %s: out of memory\n", g->width, g->height, name);
+        ssd1306_destroy_display(d);
+        return 1;
+    }
+    ssd1306_set_font(d, &ssd1306_font5x7);
+
+    srand(g->width * 31 + g->height);
+    uint32_t failures = 0;
+    draw_random(d);
+    for (uint32_t frame = 0; frame < FRAMES; frame++)
+    {
+        memcpy(expected, d->frame, d->frame_length);
+        if (path & PATH_ASYNC)
+        {
+            if (!ssd1306_update_graphics_async(d, NULL, NULL))
+                failures++;
+            /* With a second frame the next one is drawn while the transfers are pending */
+            if (path & PATH_DOUBLE_BUFFER)
+                draw_random(d);
+            ssd1306_memory_context_advance(&bus.memory, (frame * 2654435761u >> 8) % 4000);
+            ssd1306_wait_update(d);
+        }
+        else
+        {
+            ssd1306_update_graphics(d);
+        }
+        uint32_t differences = ssd1306_emulator_compare(&bus.emulator, expected, SSD1306_WIDTH(d), SSD1306_PAGES(d), g->column_offset);
+        if (differences != 0 || bus.emulator.errors != 0)
+        {
+            if (failures == 0)
+                printf("%ux%u %s: frame %u, %u GDDRAM bytes differ, %u bus errors\n", g->width, g->height, name, frame, differences,
+                       bus.emulator.errors);
+            failures++;
+        }
+        if (!(path & PATH_ASYNC) || !(path & PATH_DOUBLE_BUFFER))
+            draw_random(d);
+    }
+    *bytes = bus.memory.bytes;
+    printf("%ux%u %s: %u frames, %u bytes, %s\n", g->width, g->height, name, FRAMES, *bytes, failures ? "FAILED" : "ok");
+    ssd1306_destroy_display(d);
+    return failures;
+}
+
+int main(void)
+{
+    const SSD1306_Geometry *geometries[] = {&ssd1306_128x64, &ssd1306_128x32, &ssd1306_72x40, &ssd1306_64x48};
+    static const struct
+    {
+        const char *name;
+        uint8_t path;
+    } paths[] = {
+        {"dirty spans", 0},
+        {"diff", PATH_DIFF},
+        {"double buffer", PATH_DOUBLE_BUFFER},
+        {"double buffer diff", PATH_DOUBLE_BUFFER | PATH_DIFF},
+        {"async", PATH_ASYNC},
+        {"async diff", PATH_ASYNC | PATH_DIFF},
+        {"async double buffer", PATH_ASYNC | PATH_DOUBLE_BUFFER},
+        {"async double buffer diff", PATH_ASYNC | PATH_DOUBLE_BUFFER | PATH_DIFF},
+    };
+    uint32_t failures = 0;
+    for (size_t i = 0; i < sizeof(geometries) / sizeof(geometries[0]); i++)
+    {
+        uint32_t bytes[(PATH_ASYNC | PATH_DOUBLE_BUFFER | PATH_DIFF) + 1];
+        for (size_t j = 0; j < sizeof(paths) / sizeof(paths[0]); j++)
+            failures += check_path(geometries[i], paths[j].name, paths[j].path, &bytes[paths[j].path]);
+        for (uint8_t path = PATH_ASYNC; path < sizeof(bytes) / sizeof(bytes[0]); path += 2)
+        {
+            if (bytes[path] != bytes[path & ~PATH_ASYNC])
+            {
+                printf("%ux%u: asynchronous path %u sent %u bytes, the synchronous one %u\n", geometries[i]->width,
+                       geometries[i]->height, path, bytes[path], bytes[path & ~PATH_ASYNC]);
+                failures++;
+            }
+        }
+    }
+    return failures != 0;
+}
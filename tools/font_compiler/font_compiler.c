@@ -0,0 +1,733 @@
+/**
+ * Offline font compiler: converts a BDF font, or a PBM image holding the glyphs in a grid of
+ * cells, into the page format of SSD1306_Font. It writes OUTPUT.c with the glyph tables and the
+ * const descriptor and OUTPUT.h declaring it, in the layout of the fonts of the library.
+ *
+ * ssd1306_font_compiler [options] INPUT OUTPUT
+ *   --name NAME         name of the font in the registry, default: OUTPUT file name
+ *   --symbol SYMBOL     C name of the descriptor, default: ssd1306_font_NAME
+ *   --spacing N         columns between glyphs, default: 1
+ *   --overflow C        character drawn for the characters missing from the font, default: ?
+ *   --cell WxH          cell size of a PBM grid, required for PBM input
+ *   --first C           character of the first cell of a PBM grid, default: 32
+ *   --subset TEXT       keeps only the glyphs of the UTF-8 characters of TEXT, may be repeated
+ *   --subset-file FILE  keeps only the glyphs of the UTF-8 characters of FILE, may be repeated
+ *   --rle               compresses the glyphs with SSD1306_FONT_RLE
+ *
+ * Characters are given as themselves, as U+XXXX or as numbers of two or more digits.
+ * BDF glyphs are as wide as their advance minus the spacing, or up to their rightmost pixel if it
+ * is further. PBM glyphs are as wide as their rightmost pixel, blank cells take the cell width minus
+ * the spacing. The constant time range of the font spans its printable ASCII glyphs and the overflow
+ * character, and the ASCII control characters too when that takes fewer table bytes; the other glyphs
+ * go to its codepoint table. With --subset only the printable ASCII glyphs kept are spanned.
+ */
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Longest line of a BDF file */
+#define LINE_LENGTH 1024
+/** Codepoints accepted by --subset, the Unicode range */
+#define CODEPOINTS 0x110000u
+
+typedef struct glyph
+{
+    uint32_t codepoint;
+    uint32_t width;
+    /** Page major columns: page k of column x at columns[k * width + x] */
+    uint8_t *columns;
+} Glyph;
+
+typedef struct font
+{
+    Glyph *glyphs;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t pages;
+} Font;
+
+typedef struct options
+{
+    const char *input;
+    const char *output;
+    const char *name;
+    const char *symbol;
+    uint32_t spacing;
+    uint32_t overflow;
+    uint32_t cell_width;
+    uint32_t cell_height;
+    uint32_t first;
+    /** Bitset of the characters kept, NULL to keep every glyph */
+    uint8_t *subset;
+    bool rle;
+} Options;
+
+static void *allocate(size_t size)
+{
+    void *p = calloc(1, size);
+    if (p == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+/**
+ * Appends a blank glyph to the font
+ * @param f font, pages already known
+ * @return the glyph
+ */
+static Glyph *add_glyph(Font *f, uint32_t codepoint, uint32_t width)
+{
+    if (f->count == f->capacity)
+    {
+        f->capacity = f->capacity ? f->capacity * 2 : 128;
+        f->glyphs = realloc(f->glyphs, f->capacity * sizeof(Glyph));
+        if (f->glyphs == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    Glyph *g = &f->glyphs[f->count++];
+    g->codepoint = codepoint;
+    g->width = width;
+    g->columns = allocate(width * f->pages + 1);
+    return g;
+}
+
+static void set_pixel(const Font *f, Glyph *g, int32_t x, int32_t y)
+{
+    if (x < 0 || (uint32_t)x >= g->width || y < 0 || (uint32_t)y >= f->pages * 8)
+        return;
+    g->columns[(y >> 3) * g->width + x] |= 1u << (y & 7);
+}
+
+/**
+ * Narrows a glyph to its rightmost pixel
+ * @param minimum narrowest width
+ * @param blank width of a blank glyph
+ */
+static void trim_glyph(const Font *f, Glyph *g, uint32_t minimum, uint32_t blank)
+{
+    uint32_t width = 0;
+    for (uint32_t x = 0; x < g->width; x++)
+        for (uint32_t k = 0; k < f->pages; k++)
+            if (g->columns[k * g->width + x])
+                width = x + 1;
+    if (width == 0)
+        width = blank;
+    if (width < minimum)
+        width = minimum;
+    uint8_t *columns = allocate(width * f->pages + 1);
+    for (uint32_t k = 0; k < f->pages; k++)
+        for (uint32_t x = 0; x < width && x < g->width; x++)
+            columns[k * width + x] = g->columns[k * g->width + x];
+    free(g->columns);
+    g->columns = columns;
+    g->width = width;
+}
+
+/**
+ * Decodes the next UTF-8 character of a text
+ * @return the codepoint, CODEPOINTS for malformed sequences
+ */
+static uint32_t utf8_next(const char **text)
+{
+    const uint8_t *s = (const uint8_t *)*text;
+    uint32_t c = s[0];
+    uint32_t n = c < 0x80 ? 0 : (c & 0xe0) == 0xc0 ? 1 : (c & 0xf0) == 0xe0 ? 2 : (c & 0xf8) == 0xf0 ? 3 : 4;
+    *text += 1;
+    if (n == 0)
+        return c;
+    if (n == 4)
+        return CODEPOINTS;
+    c &= 0x3f >> n;
+    for (uint32_t i = 1; i <= n; i++)
+    {
+        if ((s[i] & 0xc0) != 0x80)
+            return CODEPOINTS;
+        c = (c << 6) | (s[i] & 0x3f);
+        *text += 1;
+    }
+    return c < CODEPOINTS ? c : CODEPOINTS;
+}
+
+static void add_subset(Options *o, const char *text)
+{
+    if (o->subset == NULL)
+        o->subset = allocate(CODEPOINTS / 8);
+    while (*text)
+    {
+        uint32_t c = utf8_next(&text);
+        if (c < CODEPOINTS && c != '\n' && c != '\r')
+            o->subset[c >> 3] |= 1u << (c & 7);
+    }
+}
+
+static bool in_subset(const Options *o, uint32_t c)
+{
+    return o->subset == NULL || c == o->overflow || (c < CODEPOINTS && (o->subset[c >> 3] >> (c & 7)) & 1);
+}
+
+static char *read_file(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        exit(1);
+    }
+    size_t length = 0, capacity = 4096;
+    char *text = allocate(capacity);
+    size_t n;
+    while ((n = fread(text + length, 1, capacity - length - 1, file)) > 0)
+    {
+        length += n;
+        if (capacity - length == 1)
+        {
+            capacity *= 2;
+            text = realloc(text, capacity);
+            if (text == NULL)
+            {
+                fprintf(stderr, "out of memory\n");
+                exit(1);
+            }
+        }
+    }
+    text[length] = 0;
+    fclose(file);
+    return text;
+}
+
+static bool keyword(const char *line, const char *word)
+{
+    size_t n = strlen(word);
+    return strncmp(line, word, n) == 0 && (line[n] == 0 || isspace((unsigned char)line[n]));
+}
+
+/**
+ * Reads a BDF font, glyphs with an ENCODING of -1 are skipped
+ */
+static bool read_bdf(const Options *o, Font *f)
+{
+    FILE *file = fopen(o->input, "r");
+    if (file == NULL)
+    {
+        perror(o->input);
+        return false;
+    }
+    char line[LINE_LENGTH];
+    int ascent = 0, descent = 0, box_height = 0, box_y = 0;
+    bool has_ascent = false, has_descent = false;
+    int encoding = -1, advance = 0, width = 0, height = 0, x_offset = 0, y_offset = 0;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (keyword(line, "FONTBOUNDINGBOX"))
+            sscanf(line + 15, "%*d %d %*d %d", &box_height, &box_y);
+        else if (keyword(line, "FONT_ASCENT"))
+            has_ascent = sscanf(line + 11, "%d", &ascent) == 1;
+        else if (keyword(line, "FONT_DESCENT"))
+            has_descent = sscanf(line + 12, "%d", &descent) == 1;
+        else if (keyword(line, "STARTCHAR"))
+            encoding = -1, advance = width = height = x_offset = y_offset = 0;
+        else if (keyword(line, "ENCODING"))
+            sscanf(line + 8, "%d", &encoding);
+        else if (keyword(line, "DWIDTH"))
+            sscanf(line + 6, "%d", &advance);
+        else if (keyword(line, "BBX"))
+            sscanf(line + 3, "%d %d %d %d", &width, &height, &x_offset, &y_offset);
+        else if (keyword(line, "BITMAP"))
+        {
+            if (!has_ascent)
+                ascent = box_height + box_y;
+            if (!has_descent)
+                descent = -box_y;
+            if (ascent + descent <= 0)
+            {
+                fprintf(stderr, "%s: font without height\n", o->input);
+                fclose(file);
+                return false;
+            }
+            f->pages = (ascent + descent + 7) / 8;
+            int32_t left = x_offset > 0 ? x_offset : 0;
+            bool keep = encoding >= 0 && in_subset(o, encoding);
+            Glyph *g = keep ? add_glyph(f, encoding, left + (width > 0 ? width : 0)) : NULL;
+            for (int32_t row = 0; row < height && fgets(line, sizeof(line), file) != NULL; row++)
+            {
+                if (g == NULL)
+                    continue;
+                int32_t y = ascent - (y_offset + height) + row;
+                for (int32_t column = 0; column < width; column++)
+                {
+                    char digit = line[column / 4];
+                    if (!isxdigit((unsigned char)digit))
+                        break;
+                    uint32_t nibble = isdigit((unsigned char)digit) ? digit - '0' : (tolower((unsigned char)digit) - 'a' + 10);
+                    if ((nibble >> (3 - column % 4)) & 1)
+                        set_pixel(f, g, left + column, y);
+                }
+            }
+            if (g != NULL)
+            {
+                uint32_t minimum = advance > (int)o->spacing ? advance - o->spacing : 0;
+                trim_glyph(f, g, minimum, minimum);
+            }
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * Reads the next PBM header number, skipping whitespace and comments
+ */
+static bool pbm_number(FILE *file, uint32_t *n)
+{
+    int c;
+    while ((c = fgetc(file)) != EOF && (isspace(c) || c == '#'))
+        if (c == '#')
+            while ((c = fgetc(file)) != EOF && c != '\n')
+                ;
+    if (c == EOF || !isdigit(c))
+        return false;
+    *n = 0;
+    for (; c != EOF && isdigit(c); c = fgetc(file))
+        *n = *n * 10 + (c - '0');
+    return true;
+}
+
+/**
+ * Reads a P1 or P4 PBM image, cells are read left to right and top to bottom from o->first
+ */
+static bool read_pbm(const Options *o, Font *f)
+{
+    FILE *file = fopen(o->input, "rb");
+    if (file == NULL)
+    {
+        perror(o->input);
+        return false;
+    }
+    char magic[2] = {0};
+    uint32_t width, height;
+    if (fread(magic, 1, 2, file) != 2 || magic[0] != 'P' || (magic[1] != '1' && magic[1] != '4') ||
+        !pbm_number(file, &width) || !pbm_number(file, &height))
+    {
+        fprintf(stderr, "%s: not a P1 or P4 PBM image\n", o->input);
+        fclose(file);
+        return false;
+    }
+    uint8_t *pixels = allocate((size_t)width * height + 1);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        int c = 0;
+        for (uint32_t x = 0; x < width; x++)
+        {
+            if (magic[1] == '1')
+            {
+                while ((c = fgetc(file)) != EOF && c != '0' && c != '1')
+                    ;
+                pixels[y * width + x] = c == '1';
+            }
+            else
+            {
+                if (x % 8 == 0)
+                    c = fgetc(file);
+                pixels[y * width + x] = (c >> (7 - x % 8)) & 1;
+            }
+        }
+    }
+    fclose(file);
+    f->pages = (o->cell_height + 7) / 8;
+    uint32_t columns = width / o->cell_width;
+    uint32_t rows = height / o->cell_height;
+    for (uint32_t cell = 0; cell < columns * rows; cell++)
+    {
+        uint32_t codepoint = o->first + cell;
+        if (!in_subset(o, codepoint))
+            continue;
+        Glyph *g = add_glyph(f, codepoint, o->cell_width);
+        uint32_t cell_x = cell % columns * o->cell_width, cell_y = cell / columns * o->cell_height;
+        for (uint32_t y = 0; y < o->cell_height; y++)
+            for (uint32_t x = 0; x < o->cell_width; x++)
+                if (pixels[(cell_y + y) * width + cell_x + x])
+                    set_pixel(f, g, x, y);
+        trim_glyph(f, g, 0, o->cell_width > o->spacing ? o->cell_width - o->spacing : 1);
+    }
+    free(pixels);
+    return true;
+}
+
+/**
+ * Compresses bytes into SSD1306_FONT_RLE runs
+ * @param out receives the runs, 2 * n bytes at most
+ * @return length of the runs
+ */
+static uint32_t rle_encode(const uint8_t *b, uint32_t n, uint32_t *out)
+{
+    uint32_t length = 0, literal = 0;
+    for (uint32_t i = 0; i <= n; i++)
+    {
+        uint32_t run = 0;
+        while (i + run < n && b[i + run] == b[i] && run < 64)
+            run++;
+        bool zeros = run > 0 && b[i] == 0 && (run >= 2 || literal == 0);
+        bool repeat = run >= 3;
+        if (i == n || zeros || repeat || literal == 128)
+        {
+            /* Flush the pending literal bytes */
+            if (literal)
+            {
+                out[length++] = literal - 1;
+                for (uint32_t j = i - literal; j < i; j++)
+                    out[length++] = b[j];
+                literal = 0;
+            }
+            if (i == n)
+                break;
+        }
+        if (zeros)
+            out[length++] = 0x80 | (run - 1);
+        else if (repeat)
+        {
+            out[length++] = 0xc0 | (run - 1);
+            out[length++] = b[i];
+        }
+        else
+        {
+            literal++;
+            continue;
+        }
+        i += run - 1;
+    }
+    return length;
+}
+
+static int compare_glyphs(const void *a, const void *b)
+{
+    uint32_t x = ((const Glyph *)a)->codepoint, y = ((const Glyph *)b)->codepoint;
+    return x < y ? -1 : x > y;
+}
+
+static const Glyph *find_glyph(const Font *f, uint32_t codepoint)
+{
+    Glyph key = {.codepoint = codepoint};
+    return bsearch(&key, f->glyphs, f->count, sizeof(Glyph), compare_glyphs);
+}
+
+/**
+ * Prints a table 16 values per line in the layout of the font files
+ */
+static void write_table(FILE *out, const char *type, const char *prefix, const char *table, const uint32_t *values,
+                        uint32_t count, const char *format)
+{
+    fprintf(out, "\nstatic const %s %s_%s[%u] = {", type, prefix, table, count ? count : 1);
+    if (count == 0)
+        fprintf(out, "0");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i % 16 == 0)
+            fprintf(out, "\n    ");
+        fprintf(out, format, values[i]);
+        if (i + 1 < count)
+            fprintf(out, i % 16 == 15 ? "," : ", ");
+    }
+    fprintf(out, "};\n");
+}
+
+static FILE *create(const char *output, const char *extension)
+{
+    char path[LINE_LENGTH];
+    snprintf(path, sizeof(path), "%s%s", output, extension);
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+        perror(path);
+    return file;
+}
+
+/**
+ * Writes OUTPUT.h and OUTPUT.c, glyphs sorted by codepoint
+ */
+static bool write_font(const Options *o, const Font *f)
+{
+    uint32_t overflow = o->overflow;
+    if (overflow >= 0x80 || find_glyph(f, overflow) == NULL)
+    {
+        uint32_t ascii = f->count > 0 && f->glyphs[0].codepoint < 0x80 ? f->glyphs[0].codepoint : 0x80;
+        if (ascii == 0x80)
+        {
+            fprintf(stderr, "%s: the font needs at least one ASCII glyph\n", o->input);
+            return false;
+        }
+        fprintf(stderr, "%s: overflow character U+%04X is not an ASCII glyph of the font, using U+%04X\n", o->input,
+                overflow, ascii);
+        overflow = ascii;
+    }
+
+    /* Constant time range: the printable ASCII glyphs and the overflow character always, so
+     * ASCII text never takes the binary search, extended over the ASCII control characters when
+     * that takes fewer table bytes, 5 per character of the span and 7 per glyph left to the
+     * codepoint table. Characters of the span missing from the font point to the overflow glyph */
+    uint32_t low = overflow, high = overflow;
+    for (uint32_t i = 0; i < f->count; i++)
+    {
+        uint32_t c = f->glyphs[i].codepoint;
+        if (c >= ' ' && c <= '~')
+        {
+            low = c < low ? c : low;
+            high = c > high ? c : high;
+        }
+    }
+    uint32_t first = low, last = high, best = UINT32_MAX;
+    uint32_t tabled = 0;
+    for (uint32_t i = 0; i < f->count; i++)
+        tabled += f->glyphs[i].codepoint <= 0xffff;
+    for (uint32_t i = 0; i < f->count && f->glyphs[i].codepoint <= low; i++)
+    {
+        for (uint32_t j = i; j < f->count && f->glyphs[j].codepoint < 0x80; j++)
+        {
+            if (f->glyphs[j].codepoint < high)
+                continue;
+            uint32_t span = f->glyphs[j].codepoint - f->glyphs[i].codepoint + 1;
+            uint32_t cost = 5 * span + 7 * (tabled - (j - i + 1));
+            if (cost < best)
+            {
+                best = cost;
+                first = f->glyphs[i].codepoint;
+                last = f->glyphs[j].codepoint;
+            }
+        }
+    }
+
+    /* Glyph order: the span, then the codepoint table */
+    uint32_t entries = last - first + 1 + f->count;
+    const Glyph **order = allocate(entries * sizeof(Glyph *));
+    uint32_t *codepoints = allocate(f->count * sizeof(uint32_t));
+    uint32_t count = 0, sparse = 0;
+    for (uint32_t c = first; c <= last; c++)
+        order[count++] = find_glyph(f, c);
+    for (uint32_t i = 0; i < f->count; i++)
+    {
+        const Glyph *g = &f->glyphs[i];
+        if (g->codepoint >= first && g->codepoint <= last)
+            continue;
+        if (g->codepoint > 0xffff)
+        {
+            fprintf(stderr, "%s: U+%04X is out of the 16 bit codepoint table, skipped\n", o->input, g->codepoint);
+            continue;
+        }
+        codepoints[sparse++] = g->codepoint;
+        order[count++] = g;
+    }
+
+    uint32_t columns = 0;
+    uint32_t *offsets = allocate(count * sizeof(uint32_t));
+    uint32_t *widths = allocate(count * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (order[i] == NULL)
+            continue;
+        offsets[i] = columns;
+        widths[i] = order[i]->width;
+        columns += order[i]->width;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (order[i] != NULL)
+            continue;
+        offsets[i] = offsets[overflow - first];
+        widths[i] = widths[overflow - first];
+    }
+    uint32_t *bytes = allocate((columns * f->pages + 1) * sizeof(uint32_t));
+    for (uint32_t k = 0; k < f->pages; k++)
+        for (uint32_t i = 0; i < count; i++)
+            for (uint32_t x = 0; order[i] != NULL && x < order[i]->width; x++)
+                bytes[k * columns + offsets[i] + x] = order[i]->columns[k * order[i]->width + x];
+    uint32_t length = columns * f->pages;
+    if (o->rle)
+    {
+        /* Every glyph becomes a stream of runs, the offsets point to the streams */
+        uint32_t *runs = allocate((2 * length + 1) * sizeof(uint32_t));
+        length = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (order[i] == NULL)
+                continue;
+            offsets[i] = length;
+            length += rle_encode(order[i]->columns, order[i]->width * f->pages, runs + length);
+        }
+        for (uint32_t i = 0; i < count; i++)
+            if (order[i] == NULL)
+                offsets[i] = offsets[overflow - first];
+        free(bytes);
+        bytes = runs;
+    }
+    uint32_t *vertical = allocate(f->pages * sizeof(uint32_t));
+    for (uint32_t k = 1; k < f->pages; k++)
+        vertical[k - 1] = k * columns;
+
+    const char *base = strrchr(o->output, '/') ? strrchr(o->output, '/') + 1 : o->output;
+    const char *prefix = strncmp(o->symbol, "ssd1306_", 8) == 0 ? o->symbol + 8 : o->symbol;
+    FILE *header = create(o->output, ".h");
+    FILE *source = create(o->output, ".c");
+    if (header == NULL || source == NULL)
+        return false;
+
+    char guard[LINE_LENGTH];
+    size_t n = 0;
+    for (; base[n] && n + 3 < sizeof(guard); n++)
+        guard[n] = isalnum((unsigned char)base[n]) ? toupper((unsigned char)base[n]) : '_';
+    strcpy(guard + n, "_H_");
+    fprintf(header, "#ifndef %s\n#define %s\n\n#include \"ssd1306_font.h\"\n\n", guard, guard);
+    fprintf(header, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n");
+    fprintf(header, "/**\n * %u pixels high font of %u glyphs, generated by ssd1306_font_compiler from %s\n */\n",
+            f->pages * 8, count, o->input);
+    fprintf(header, "extern const SSD1306_Font %s;\n\n#ifdef __cplusplus\n}\n#endif\n#endif\n", o->symbol);
+
+    fprintf(source, "#include \"%s.h\"\n", base);
+    write_table(source, "uint8_t", prefix, "array", bytes, length, "0x%02x");
+    write_table(source, "uint32_t", prefix, "character_offset", offsets, count, "%u");
+    write_table(source, "uint8_t", prefix, "character_width", widths, count, "%u");
+    if (!o->rle)
+        write_table(source, "uint32_t", prefix, "vertical_offsets", vertical, f->pages - 1, "%uu");
+    if (sparse)
+        write_table(source, "uint16_t", prefix, "codepoints", codepoints, sparse, "0x%04x");
+    fprintf(source, "\nconst SSD1306_Font %s = {\n", o->symbol);
+    fprintf(source, "    .name = \"%s\",\n", o->name);
+    fprintf(source, "    .first_character = %u,\n    .last_character = %u,\n    .overflow_character = %u,\n", first, last, overflow);
+    fprintf(source, "    .font_array = %s_array,\n", prefix);
+    fprintf(source, "    .character_offset = %s_character_offset,\n", prefix);
+    fprintf(source, "    .character_width = %s_character_width,\n", prefix);
+    fprintf(source, "    .character_height = %uu,\n", f->pages);
+    if (!o->rle)
+        fprintf(source, "    .vertical_offsets = %s_vertical_offsets,\n", prefix);
+    fprintf(source, "    .character_spacing = %uu", o->spacing);
+    if (sparse)
+        fprintf(source, ",\n    .codepoints = %s_codepoints,\n    .codepoint_count = %uu", prefix, sparse);
+    if (o->rle)
+        fprintf(source, ",\n    .encoding = SSD1306_FONT_RLE");
+    fprintf(source, "};\n");
+    fclose(header);
+    fclose(source);
+    printf("%s: %u glyphs, %u bytes of glyphs, %u bytes of tables\n", o->symbol, count, length,
+           count * 5 + sparse * 2 + (o->rle ? 0 : (f->pages > 1 ? f->pages - 1 : 1) * 4));
+    free(order);
+    free(codepoints);
+    free(offsets);
+    free(widths);
+    free(bytes);
+    free(vertical);
+    return true;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: ssd1306_font_compiler [--name NAME] [--symbol SYMBOL] [--spacing N] [--overflow C]\n"
+                    "                             [--cell WxH] [--first C] [--subset TEXT] [--subset-file FILE] [--rle]\n"
+                    "                             INPUT.bdf|INPUT.pbm OUTPUT\n");
+    exit(2);
+}
+
+/**
+ * Parses a character option: a single UTF-8 character, U+XXXX or a number of two or more digits
+ */
+static uint32_t character_option(const char *s)
+{
+    const char *t = s;
+    uint32_t c = utf8_next(&t);
+    if (*t == 0)
+        return c;
+    if (s[0] == 'U' && s[1] == '+')
+        return (uint32_t)strtoul(s + 2, NULL, 16);
+    return (uint32_t)strtoul(s, NULL, 0);
+}
+
+int main(int argc, char **argv)
+{
+    Options o = {.spacing = 1, .overflow = '?', .first = 32};
+    char name[LINE_LENGTH];
+    char symbol[LINE_LENGTH];
+    int i = 1;
+    for (; i < argc && strncmp(argv[i], "--", 2) == 0; i++)
+    {
+        if (strcmp(argv[i], "--rle") == 0)
+        {
+            o.rle = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+            usage();
+        const char *value = argv[++i];
+        if (strcmp(argv[i - 1], "--name") == 0)
+            o.name = value;
+        else if (strcmp(argv[i - 1], "--symbol") == 0)
+            o.symbol = value;
+        else if (strcmp(argv[i - 1], "--spacing") == 0)
+            o.spacing = (uint32_t)strtoul(value, NULL, 0);
+        else if (strcmp(argv[i - 1], "--overflow") == 0)
+            o.overflow = character_option(value);
+        else if (strcmp(argv[i - 1], "--first") == 0)
+            o.first = character_option(value);
+        else if (strcmp(argv[i - 1], "--cell") == 0)
+        {
+            if (sscanf(value, "%ux%u", &o.cell_width, &o.cell_height) != 2 || o.cell_width == 0 || o.cell_height == 0)
+                usage();
+        }
+        else if (strcmp(argv[i - 1], "--subset") == 0)
+            add_subset(&o, value);
+        else if (strcmp(argv[i - 1], "--subset-file") == 0)
+        {
+            char *text = read_file(value);
+            add_subset(&o, text);
+            free(text);
+        }
+        else
+            usage();
+    }
+    if (argc - i != 2)
+        usage();
+    o.input = argv[i];
+    o.output = argv[i + 1];
+    if (o.name == NULL)
+    {
+        const char *base = strrchr(o.output, '/') ? strrchr(o.output, '/') + 1 : o.output;
+        snprintf(name, sizeof(name), "%s", base);
+        o.name = name;
+    }
+    if (o.symbol == NULL)
+    {
+        size_t n = snprintf(symbol, sizeof(symbol), "ssd1306_font_%s", o.name);
+        for (size_t j = 0; j < n && j < sizeof(symbol); j++)
+            if (!isalnum((unsigned char)symbol[j]))
+                symbol[j] = '_';
+        o.symbol = symbol;
+    }
+
+    Font f = {0};
+    size_t length = strlen(o.input);
+    bool pbm = length > 4 && strcmp(o.input + length - 4, ".pbm") == 0;
+    if (pbm && o.cell_width == 0)
+    {
+        fprintf(stderr, "%s: a PBM grid needs --cell WxH\n", o.input);
+        return 1;
+    }
+    if (!(pbm ? read_pbm(&o, &f) : read_bdf(&o, &f)))
+        return 1;
+    qsort(f.glyphs, f.count, sizeof(Glyph), compare_glyphs);
+    for (uint32_t j = 1; j < f.count; j++)
+        if (f.glyphs[j].codepoint == f.glyphs[j - 1].codepoint)
+        {
+            fprintf(stderr, "%s: U+%04X defined twice\n", o.input, f.glyphs[j].codepoint);
+            return 1;
+        }
+    bool written = write_font(&o, &f);
+    for (uint32_t j = 0; j < f.count; j++)
+        free(f.glyphs[j].columns);
+    free(f.glyphs);
+    free(o.subset);
+    return written ? 0 : 1;
+}